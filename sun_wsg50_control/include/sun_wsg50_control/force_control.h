@@ -0,0 +1,78 @@
+/*
+    Normal force controller, used by the force_control node and nodelet
+
+    Copyright 2018-2019 Università della Campania Luigi Vanvitelli
+
+    Author: Marco Costanzo <marco.costanzo@unicampania.it>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SUN_WSG50_CONTROL_FORCE_CONTROL_H
+#define SUN_WSG50_CONTROL_FORCE_CONTROL_H
+
+#include "ros/ros.h"
+
+#include <geometry_msgs/WrenchStamped.h>
+#include <std_msgs/Float64.h>
+#include <sun_ros_msgs/Float64Stamped.h>
+#include "std_srvs/SetBool.h"
+
+namespace sun_wsg50_control
+{
+
+class ForceControl
+{
+public:
+    ForceControl(const ros::NodeHandle& nh_public, const ros::NodeHandle& nh_private);
+
+    /** Read the parameters, advertise and subscribe. false on invalid parameters */
+    bool init();
+
+    void sendZeroVel();
+
+private:
+    double inv_stiff(double f);
+    void applyControl();
+
+    void readForceWrenchStamped(const geometry_msgs::WrenchStamped::ConstPtr& forceMsg);
+    void readForceWrench(const geometry_msgs::Wrench::ConstPtr& forceMsg);
+    void readForceFloat64(const std_msgs::Float64::ConstPtr& forceMsg);
+    void readForceFloat64Stamped(const sun_ros_msgs::Float64Stamped::ConstPtr& forceMsg);
+    void readCommand(const sun_ros_msgs::Float64Stamped::ConstPtr& forceMsg);
+
+    void stopSubscribers();
+    void startSubscribers();
+    bool setRunning_callbk(std_srvs::SetBool::Request& req, std_srvs::SetBool::Response& res);
+
+    ros::NodeHandle nh_public_, nh_private_;
+    ros::Publisher velPub_;
+    ros::Subscriber force_sub_, force_command_sub_;
+    ros::ServiceServer servicePause_;
+
+    std::string topic_force_command_str_;
+    std::string topic_measure_str_;
+    std::string topic_measure_type_str_;
+
+    double fz_, fr_;
+    double max_force_;
+    double control_gain_;
+    double stiff_1_, stiff_2_;
+    bool b_linear_model_;
+    bool running_;
+};
+
+}
+
+#endif
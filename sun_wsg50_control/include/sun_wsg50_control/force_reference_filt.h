@@ -0,0 +1,60 @@
+/*
+    Force reference filter, used by the force_reference_filt node and nodelet
+
+    Copyright 2018 Università della Campania Luigi Vanvitelli
+
+	Author: Marco Costanzo <marco.costanzo@unicampania.it>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SUN_WSG50_CONTROL_FORCE_REFERENCE_FILT_H
+#define SUN_WSG50_CONTROL_FORCE_REFERENCE_FILT_H
+
+#include <memory>
+
+#include "ros/ros.h"
+
+#include "sun_ros_msgs/Float64Stamped.h"
+#include "sun_systems_lib/TF/TF_FIRST_ORDER_FILTER.h"
+
+namespace sun_wsg50_control
+{
+
+class ForceReferenceFilt
+{
+public:
+    ForceReferenceFilt(const ros::NodeHandle& nh_public, const ros::NodeHandle& nh_private);
+
+    /** Read the parameters, advertise, subscribe and start the filter timer */
+    void init();
+
+private:
+    void readRef(const sun_ros_msgs::Float64Stamped::ConstPtr& msg);
+    void readMeasure(const sun_ros_msgs::Float64Stamped::ConstPtr& msg);
+    void loop(const ros::TimerEvent& ev);
+
+    ros::NodeHandle nh_public_, nh_private_;
+    ros::Publisher pubFloatFilter_;
+    ros::Subscriber subRef_, subMeasure_;
+    ros::Timer timer_;
+
+    std::unique_ptr<sun::TF_FIRST_ORDER_FILTER> filter_;
+    double fr_, fm_;
+    double max_force_;
+};
+
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+    Gripper width monitoring, used by the status_monitoring node and nodelet
+
+    Copyright 2018-2019 Università della Campania Luigi Vanvitelli
+
+    Author: Marco Costanzo <marco.costanzo@unicampania.it>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SUN_WSG50_CONTROL_STATUS_MONITORING_H
+#define SUN_WSG50_CONTROL_STATUS_MONITORING_H
+
+#include "ros/ros.h"
+#include "sun_ros_msgs/Float64Stamped.h"
+
+namespace sun_wsg50_control
+{
+
+class StatusMonitoring
+{
+public:
+    StatusMonitoring(const ros::NodeHandle& nh_public, const ros::NodeHandle& nh_private);
+
+    /** Read the parameters, advertise and subscribe */
+    void init();
+
+private:
+    void width_cb(const sun_ros_msgs::Float64Stamped::ConstPtr& width_msg);
+    void monitor_cb(const sun_ros_msgs::Float64Stamped::ConstPtr& speed_in);
+
+    ros::NodeHandle nh_public_, nh_private_;
+    ros::Publisher pub_speed_;
+    ros::Subscriber sub_width_, sub_speed_;
+
+    double width_min_, width_max_, width_;
+};
+
+}
+
+#endif
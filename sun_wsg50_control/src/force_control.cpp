@@ -0,0 +1,225 @@
+/*
+    Normal force controller
+
+    Copyright 2018-2019 Università della Campania Luigi Vanvitelli
+
+    Author: Marco Costanzo <marco.costanzo@unicampania.it>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+
+#include "sun_wsg50_control/force_control.h"
+
+/* ======= COLORS ========= */
+#define CRESET   "\033[0m"
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+#define BOLDRED     "\033[1m\033[31m"      /* Bold Red */
+#define BOLDGREEN   "\033[1m\033[32m"      /* Bold Green */
+#define BOLDYELLOW  "\033[1m\033[33m"      /* Bold Yellow */
+/*===============================*/
+
+#define HEADER_PRINT BOLDYELLOW "[Force Controller]: " CRESET
+
+using namespace std;
+
+namespace sun_wsg50_control
+{
+
+constexpr unsigned int str2int(const char* str, int h = 0)
+{
+    return !str[h] ? 5381 : (str2int(str, h+1) * 33) ^ str[h];
+}
+
+ForceControl::ForceControl(const ros::NodeHandle& nh_public, const ros::NodeHandle& nh_private)
+    : nh_public_(nh_public), nh_private_(nh_private), fz_(0.0), fr_(0.0), running_(true)
+{
+}
+
+double ForceControl::inv_stiff(double f){
+    if(b_linear_model_){
+        return f/stiff_1_;
+    } else{
+        return sqrt( fabs(f)/stiff_2_ );
+    }
+}
+
+void ForceControl::applyControl(){
+    // Published by pointer: no serialization for subscribers in the same nodelet manager
+    sun_ros_msgs::Float64StampedPtr velMsg(new sun_ros_msgs::Float64Stamped);
+    if(fabs(fz_)>max_force_)
+    {
+        if( fabs(fr_) > fabs(fz_))
+        {
+        velMsg->data = 0;
+        velMsg->header.stamp = ros::Time::now();
+        velPub_.publish(velMsg);
+        return;
+        }
+    }
+
+    double dx = inv_stiff(fz_);
+    double dx_r = inv_stiff(fr_);
+    velMsg->data = -control_gain_*(dx_r-fabs(dx));
+    velMsg->data = velMsg->data*1.0E3; // m/s  to mm/s
+    velMsg->header.stamp = ros::Time::now();
+    velPub_.publish(velMsg);
+}
+
+void ForceControl::readForceWrenchStamped(const geometry_msgs::WrenchStamped::ConstPtr& forceMsg){
+	fz_ = forceMsg->wrench.force.z;
+	applyControl();
+}
+void ForceControl::readForceWrench(const geometry_msgs::Wrench::ConstPtr& forceMsg){
+	fz_ = forceMsg->force.z;
+	applyControl();
+}
+void ForceControl::readForceFloat64(const std_msgs::Float64::ConstPtr& forceMsg){
+	fz_ = forceMsg->data;
+	applyControl();
+}
+void ForceControl::readForceFloat64Stamped(const sun_ros_msgs::Float64Stamped::ConstPtr& forceMsg){
+	fz_ = forceMsg->data;
+	applyControl();
+}
+
+void ForceControl::readCommand(const sun_ros_msgs::Float64Stamped::ConstPtr& forceMsg){
+
+	fr_ = fabs(forceMsg->data);
+    //saturation
+    // if(fr>max_force){
+    //     fr = max_force;
+    //     //cout << HEADER_PRINT << BOLDRED << "MAX FORCE!" << max_force << CRESET << endl;
+    // }
+}
+
+void ForceControl::sendZeroVel(){
+    sun_ros_msgs::Float64StampedPtr velMsg(new sun_ros_msgs::Float64Stamped);
+    velMsg->data = 0.0;
+    velMsg->header.stamp = ros::Time::now();
+    velPub_.publish(velMsg);
+    velPub_.publish(velMsg);
+    velPub_.publish(velMsg);
+    velPub_.publish(velMsg);
+}
+
+void ForceControl::stopSubscribers(){
+    force_sub_.shutdown();
+    force_command_sub_.shutdown();
+}
+
+void ForceControl::startSubscribers(){
+    switch (str2int(topic_measure_type_str_.c_str()))
+    {
+        case str2int("Float64"):{
+            force_sub_ = nh_public_.subscribe(topic_measure_str_, 1, &ForceControl::readForceFloat64, this);
+            break;
+        }
+
+        case str2int("Float64Stamped"):{
+            force_sub_ = nh_public_.subscribe(topic_measure_str_, 1, &ForceControl::readForceFloat64Stamped, this);
+            break;
+        }
+
+        case str2int("WrenchStamped"):{
+            force_sub_ = nh_public_.subscribe(topic_measure_str_, 1, &ForceControl::readForceWrenchStamped, this);
+            break;
+        }
+
+        case str2int("Wrench"):{
+            force_sub_ = nh_public_.subscribe(topic_measure_str_, 1, &ForceControl::readForceWrench, this);
+            break;
+        }
+    }
+	force_command_sub_ = nh_public_.subscribe(topic_force_command_str_, 1, &ForceControl::readCommand, this);
+}
+
+/*Pause callback*/
+bool ForceControl::setRunning_callbk(std_srvs::SetBool::Request  &req, 
+   		 		std_srvs::SetBool::Response &res){
+
+    if(req.data){
+
+        if(!running_){
+            startSubscribers();
+		    cout << HEADER_PRINT GREEN "STARTED!" CRESET << endl;
+        }
+        running_ = true;
+
+	} else{
+        stopSubscribers();
+        sendZeroVel();
+        running_ = false;
+		cout << HEADER_PRINT YELLOW "PAUSED!" CRESET << endl;  
+    }
+
+    res.success = true;
+	return true;
+}
+
+bool ForceControl::init(){
+
+    nh_private_.param("topic_measure" , topic_measure_str_, string("grasp_force") );
+    nh_private_.param("topic_measure_type" , topic_measure_type_str_, string("Float64Stamped") );
+    
+    nh_private_.param("topic_force_command" , topic_force_command_str_, string("command_force") );
+	string topic_goal_speed("");
+    nh_private_.param("topic_goal_speed" , topic_goal_speed, string("goal_speed") );
+
+    string set_running_service_str("");
+    nh_private_.param("set_running_service" , set_running_service_str, string("set_running") );
+    nh_private_.param("start_running" , running_, false );
+
+    nh_private_.param("control_gain" , control_gain_, 1.0 );
+    nh_private_.param("max_force" , max_force_, 20.0 );
+    nh_private_.param("stiff_1" , stiff_1_, 5000.0 );
+    nh_private_.param("stiff_2" , stiff_2_, 5.0839*1.0E6 );
+    nh_private_.param("use_linear_model" , b_linear_model_, false );
+
+    switch (str2int(topic_measure_type_str_.c_str()))
+    {
+        case str2int("Float64"):
+        case str2int("Float64Stamped"):
+        case str2int("WrenchStamped"):
+        case str2int("Wrench"):
+            break;
+        default:{
+            cout << HEADER_PRINT BOLDRED "Invalid topic_measure_type_str = " << YELLOW << topic_measure_type_str_ << CRESET << endl;
+            return false;
+        }
+    }
+
+    control_gain_ = fabs(control_gain_);
+    max_force_ = fabs(max_force_);
+
+    if(stiff_1_ <= 0 || stiff_2_ <= 0){
+        cout << HEADER_PRINT BOLDRED "Both stiff have to be > 0 | Fatal ERROR" CRESET << endl;
+        return false;
+    }
+
+	 // Publisher
+	 velPub_ = nh_public_.advertise<sun_ros_msgs::Float64Stamped>( topic_goal_speed,1);
+     if(running_){
+        startSubscribers();
+     }
+
+    servicePause_ = nh_public_.advertiseService(set_running_service_str, &ForceControl::setRunning_callbk, this);
+
+    return true;
+}
+
+}
@@ -0,0 +1,99 @@
+/*
+    Force reference filter
+
+    Copyright 2018 Università della Campania Luigi Vanvitelli
+
+	Author: Marco Costanzo <marco.costanzo@unicampania.it>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sun_wsg50_control/force_reference_filt.h"
+
+using namespace std;
+
+namespace sun_wsg50_control
+{
+
+ForceReferenceFilt::ForceReferenceFilt(const ros::NodeHandle& nh_public, const ros::NodeHandle& nh_private)
+    : nh_public_(nh_public), nh_private_(nh_private), fr_(0.0), fm_(0.0), max_force_(15.0)
+{
+}
+
+//==========TOPICs CALLBKs=========//
+void ForceReferenceFilt::readRef( const sun_ros_msgs::Float64Stamped::ConstPtr& msg  ){
+
+    fr_ = msg->data;
+	
+}
+
+void ForceReferenceFilt::readMeasure( const sun_ros_msgs::Float64Stamped::ConstPtr& msg  ){
+
+    fm_ = msg->data;
+	
+}
+
+//====================================//
+
+void ForceReferenceFilt::init()
+{
+
+    /**** PARAMS ****/
+    string str_in_topic = string("");
+    nh_private_.param("in_topic" , str_in_topic, string("/tactile") );
+    string str_measure_topic = string("");
+    nh_private_.param("measure_topic" , str_measure_topic, string("/tactile") );
+    string str_out_topic = string("");
+    nh_private_.param("out_topic" , str_out_topic, str_in_topic + string("/filter") );
+    double cut_freq;
+    nh_private_.param("cut_freq" , cut_freq, 20.0 );
+    double Hz;
+    nh_private_.param("rate" , Hz, 500.0 );
+    nh_private_.param("max_force" , max_force_, 15.0 );
+	/************************************/
+
+    /*******INIT ROS PUB**********/
+	//Float_filter pub
+	pubFloatFilter_ = nh_public_.advertise<sun_ros_msgs::Float64Stamped>( str_out_topic, 1);
+    /***************************/
+
+    /*******INIT ROS SUB**********/
+	subRef_ = nh_public_.subscribe( str_in_topic , 1, &ForceReferenceFilt::readRef, this);
+    subMeasure_ = nh_public_.subscribe( str_measure_topic , 1, &ForceReferenceFilt::readMeasure, this);
+    /***************************/
+
+    /******INIT FILTER************/
+    filter_.reset(new sun::TF_FIRST_ORDER_FILTER(cut_freq, 1.0/Hz));
+    /***************************/	
+
+    /*============LOOP==============*/
+    timer_ = nh_public_.createTimer(ros::Duration(1.0/Hz), &ForceReferenceFilt::loop, this);
+}
+
+void ForceReferenceFilt::loop(const ros::TimerEvent& ev)
+{
+    double fr_star = fr_;
+    if(fabs(fm_)>max_force_)
+    {
+        fr_star = max_force_;
+    }
+
+    // Published by pointer: no serialization for subscribers in the same nodelet manager
+    sun_ros_msgs::Float64StampedPtr msgFloatFilter(new sun_ros_msgs::Float64Stamped);
+    msgFloatFilter->data = filter_->apply( fr_star );
+    msgFloatFilter->header.stamp = ros::Time::now();
+	pubFloatFilter_.publish( msgFloatFilter );
+}
+
+}
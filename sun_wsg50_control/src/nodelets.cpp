@@ -0,0 +1,82 @@
+/*
+    Nodelets of the force control pipeline: force_reference_filt,
+    force_control and status_monitoring. Loaded into the manager of the
+    driver nodelet, Float64Stamped messages are passed by pointer.
+
+    Copyright 2026 Università della Campania Luigi Vanvitelli
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <memory>
+
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_list_macros.h>
+
+#include "sun_wsg50_control/force_control.h"
+#include "sun_wsg50_control/force_reference_filt.h"
+#include "sun_wsg50_control/status_monitoring.h"
+
+namespace sun_wsg50_control
+{
+
+class ForceReferenceFiltNodelet : public nodelet::Nodelet
+{
+    std::unique_ptr<ForceReferenceFilt> filt_;
+
+    virtual void onInit()
+    {
+        filt_.reset(new ForceReferenceFilt(getNodeHandle(), getPrivateNodeHandle()));
+        filt_->init();
+    }
+};
+
+class ForceControlNodelet : public nodelet::Nodelet
+{
+    std::unique_ptr<ForceControl> control_;
+
+public:
+    virtual ~ForceControlNodelet()
+    {
+        if(control_)
+            control_->sendZeroVel();
+    }
+
+private:
+    virtual void onInit()
+    {
+        control_.reset(new ForceControl(getNodeHandle(), getPrivateNodeHandle()));
+        if(!control_->init()){
+            NODELET_ERROR("Invalid parameters, force control not started");
+            control_.reset();
+        }
+    }
+};
+
+class StatusMonitoringNodelet : public nodelet::Nodelet
+{
+    std::unique_ptr<StatusMonitoring> monitoring_;
+
+    virtual void onInit()
+    {
+        monitoring_.reset(new StatusMonitoring(getNodeHandle(), getPrivateNodeHandle()));
+        monitoring_->init();
+    }
+};
+
+}
+
+PLUGINLIB_EXPORT_CLASS(sun_wsg50_control::ForceReferenceFiltNodelet, nodelet::Nodelet)
+PLUGINLIB_EXPORT_CLASS(sun_wsg50_control::ForceControlNodelet, nodelet::Nodelet)
+PLUGINLIB_EXPORT_CLASS(sun_wsg50_control::StatusMonitoringNodelet, nodelet::Nodelet)
@@ -0,0 +1,82 @@
+/*
+    Gripper width monitoring
+
+    Copyright 2018-2019 Università della Campania Luigi Vanvitelli
+
+    Author: Marco Costanzo <marco.costanzo@unicampania.it>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sun_wsg50_control/status_monitoring.h"
+
+using namespace std;
+
+namespace sun_wsg50_control
+{
+
+StatusMonitoring::StatusMonitoring(const ros::NodeHandle& nh_public, const ros::NodeHandle& nh_private)
+    : nh_public_(nh_public), nh_private_(nh_private), width_min_(0.018), width_max_(0.108), width_(0.0)
+{
+}
+
+void StatusMonitoring::width_cb(const sun_ros_msgs::Float64Stamped::ConstPtr& width_msg)
+{
+    width_ = width_msg->data;
+}
+
+void StatusMonitoring::monitor_cb(const sun_ros_msgs::Float64Stamped::ConstPtr& speed_in)
+{
+
+    // Published by pointer: no serialization for subscribers in the same nodelet manager
+    sun_ros_msgs::Float64StampedPtr speed_out(new sun_ros_msgs::Float64Stamped);
+    if( (width_ >= width_max_ && speed_in->data > 0.0) || (width_ <= width_min_ && speed_in->data < 0.0) ){
+        speed_out->data = 0.0;
+        ROS_WARN_THROTTLE( 10 ,"GRIPPER MONITORING: INVALID WIDTH");
+    } else {
+        speed_out->data = speed_in->data;
+    }
+
+    //Check invalid inputs
+    if( isinf(speed_out->data) || isnan(speed_out->data) )
+    {
+        ROS_ERROR_THROTTLE( 0.5 ,"GRIPPER MONITORING: INF OR NAN: %lf", speed_out->data );
+        speed_out->data = 0.0;
+    }
+
+    speed_out->header = speed_in->header;
+    pub_speed_.publish(speed_out);
+
+}
+
+void StatusMonitoring::init()
+{
+    //Params
+    nh_private_.param("width_min" , width_min_, 0.018 );
+    nh_private_.param("width_max" , width_max_, 0.108 );
+
+    string topic_goal_speed_in("");
+    nh_private_.param("topic_goal_speed_in" , topic_goal_speed_in, string("goal_speed/unmonitored") );
+    string topic_goal_speed_out("");
+    nh_private_.param("topic_goal_speed_out" , topic_goal_speed_out, string("goal_speed") );
+    string topic_width("");
+    nh_private_.param("topic_width" , topic_width, string("width") );
+
+    //Pub/Sub
+    pub_speed_ = nh_public_.advertise<sun_ros_msgs::Float64Stamped>(topic_goal_speed_out, 1);
+    sub_width_ = nh_public_.subscribe(topic_width, 1, &StatusMonitoring::width_cb, this);
+    sub_speed_ = nh_public_.subscribe(topic_goal_speed_in, 1, &StatusMonitoring::monitor_cb, this);
+}
+
+}
@@ -0,0 +1,421 @@
+//======================================================================
+/**
+ *  @file
+ *  wsg50_benchmarks.cpp
+ *
+ *  @section wsg50_benchmarks.cpp_general General file information
+ *
+ *  @brief
+ *  Google Benchmark suite for the protocol hot paths of wsg50_core.
+ *
+ *  All benchmarks run against an in-memory interface, no gripper or
+ *  network is needed. The memory interface replays a prepared response
+ *  frame on every read and discards everything written, so msg_send(),
+ *  msg_receive() and script_measure_move() run the same code as with
+ *  the TCP/UDP/serial interfaces except for the system calls.
+ *
+ *  Run with "make run_benchmarks" (plain CMake) or "catkin run_tests".
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section wsg50_benchmarks.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "wsg_50/common.h"
+#include "wsg_50/checksum.h"
+#include "wsg_50/cmd.h"
+#include "wsg_50/interface.h"
+#include "wsg_50/msg.h"
+#include "wsg_50/gripper.h"
+#include "wsg_50/functions.h"
+#include "wsg_50/sample_log.h"
+#include "wsg_50/state_estimator.h"
+#include "wsg_50/tactile.h"
+#include "wsg_50/tactile_calibration.h"
+
+
+//------------------------------------------------------------------------
+// Memory interface
+//------------------------------------------------------------------------
+
+static std::vector<unsigned char> mem_rx;
+static size_t mem_rx_pos = 0;
+
+static int mem_open( const void *params ) { (void) params; mem_rx_pos = 0; return 0; }
+static void mem_close( void ) {}
+
+static int mem_read( unsigned char *buf, unsigned int len )
+{
+	size_t n;
+
+	if ( mem_rx.empty() ) return 0;
+	if ( mem_rx_pos >= mem_rx.size() ) mem_rx_pos = 0;
+
+	n = mem_rx.size() - mem_rx_pos;
+	if ( len < n ) n = len;
+	memcpy( buf, &mem_rx[mem_rx_pos], n );
+	mem_rx_pos += n;
+
+	return (int) n;
+}
+
+static int mem_write( unsigned char *buf, unsigned int len )
+{
+	benchmark::DoNotOptimize( buf );
+	return (int) len;
+}
+
+static const interface_t mem_iface = { "memory", mem_open, mem_close, mem_read, mem_write };
+
+
+/**
+ * Build a complete frame (preamble, header, payload, checksum)
+ */
+
+static std::vector<unsigned char> make_frame( unsigned char id, const unsigned char *payload, unsigned int len )
+{
+	std::vector<unsigned char> f( GRIPPER_HEADER_LEN + len + 2 );
+	unsigned short crc;
+
+	for ( unsigned int i = 0; i < MSG_PREAMBLE_LEN; i++ ) f[i] = MSG_PREAMBLE_BYTE;
+	f[MSG_PREAMBLE_LEN] = id;
+	f[MSG_PREAMBLE_LEN + 1] = lo( len );
+	f[MSG_PREAMBLE_LEN + 2] = hi( len );
+	if ( len > 0 ) memcpy( &f[GRIPPER_HEADER_LEN], payload, len );
+
+	crc = checksum_crc16( &f[0], GRIPPER_HEADER_LEN + len );
+	f[GRIPPER_HEADER_LEN + len] = lo( crc );
+	f[GRIPPER_HEADER_LEN + len + 1] = hi( crc );
+
+	return f;
+}
+
+
+/**
+ * Response of the measure script: status, position, speed, motor force
+ */
+
+static std::vector<unsigned char> script_response( unsigned char id )
+{
+	unsigned char payload[14] = { 0, 0 };
+	float position = 42.5f, speed = 12.25f, force = 3.5f;
+
+	memcpy( &payload[2], &position, sizeof( float ) );
+	memcpy( &payload[6], &speed, sizeof( float ) );
+	memcpy( &payload[10], &force, sizeof( float ) );
+
+	return make_frame( id, payload, sizeof( payload ) );
+}
+
+
+static void use_memory_interface( const std::vector<unsigned char> &rx )
+{
+	mem_rx = rx;
+	mem_rx_pos = 0;
+	if ( !cmd_is_connected() ) cmd_connect_interface( &mem_iface, NULL );
+}
+
+
+//------------------------------------------------------------------------
+// Benchmarks
+//------------------------------------------------------------------------
+
+static void BM_checksum_crc16( benchmark::State &state )
+{
+	std::vector<unsigned char> data( state.range( 0 ) );
+
+	for ( size_t i = 0; i < data.size(); i++ ) data[i] = (unsigned char) ( i * 31 + 7 );
+
+	for ( auto _ : state )
+	{
+		unsigned short crc = checksum_crc16( &data[0], (unsigned int) data.size() );
+		benchmark::DoNotOptimize( crc );
+	}
+	state.SetBytesProcessed( (int64_t) state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( BM_checksum_crc16 )->Arg( 8 )->Arg( 64 )->Arg( 512 );
+
+
+static void BM_convert( benchmark::State &state )
+{
+	unsigned char b[4];
+	float f = 68.25f;
+
+	memcpy( b, &f, sizeof( float ) );
+
+	for ( auto _ : state )
+	{
+		benchmark::DoNotOptimize( b );
+		float v = convert( b );
+		benchmark::DoNotOptimize( v );
+	}
+}
+BENCHMARK( BM_convert );
+
+
+static void BM_getStateValues( benchmark::State &state )
+{
+	// Payload of the system state response: status, 4 bytes state flags
+	unsigned char b[6] = { 0, 0, 0, 0, 0, 0 };
+
+	b[2] = (unsigned char) state.range( 0 );
+	b[3] = (unsigned char) ( state.range( 0 ) >> 8 );
+
+	for ( auto _ : state )
+	{
+		const char *text = getStateValues( b );
+		benchmark::DoNotOptimize( text );
+	}
+}
+BENCHMARK( BM_getStateValues )->Arg( 0x0001 )->Arg( 0xffff );
+
+
+static void BM_msg_send( benchmark::State &state )
+{
+	std::vector<unsigned char> payload( state.range( 0 ), 0x5a );
+	msg_t msg;
+
+	use_memory_interface( std::vector<unsigned char>() );
+
+	msg.id = 0xB0;
+	msg.len = (unsigned int) payload.size();
+	msg.data = payload.empty() ? NULL : &payload[0];
+
+	for ( auto _ : state )
+	{
+		int res = msg_send( &msg );
+		benchmark::DoNotOptimize( res );
+	}
+	state.SetBytesProcessed( (int64_t) state.iterations() * ( state.range( 0 ) + 8 ) );
+}
+BENCHMARK( BM_msg_send )->Arg( 0 )->Arg( 9 )->Arg( 64 );
+
+
+static void BM_msg_receive( benchmark::State &state )
+{
+	std::vector<unsigned char> payload( state.range( 0 ), 0x5a );
+	msg_t msg;
+
+	use_memory_interface( make_frame( 0x43, payload.empty() ? NULL : &payload[0], (unsigned int) payload.size() ) );
+
+	for ( auto _ : state )
+	{
+		int res = msg_receive( &msg );
+		if ( res < 0 )
+		{
+			state.SkipWithError( "msg_receive failed" );
+			break;
+		}
+		benchmark::DoNotOptimize( msg.data );
+		msg_free( &msg );
+	}
+	state.SetBytesProcessed( (int64_t) state.iterations() * ( state.range( 0 ) + 8 ) );
+}
+BENCHMARK( BM_msg_receive )->Arg( 6 )->Arg( 10 )->Arg( 64 );
+
+
+static void BM_gripper_receive( benchmark::State &state )
+{
+	std::vector<unsigned char> payload( state.range( 0 ), 0x5a );
+	std::vector<unsigned char> frame = make_frame( 0x43, payload.empty() ? NULL : &payload[0], (unsigned int) payload.size() );
+	SimGripper gripper;
+	msg_t msg;
+
+	gripper.transport().feed( &frame[0], (unsigned int) frame.size() );
+	gripper.transport().set_loop( true );
+
+	for ( auto _ : state )
+	{
+		int res = gripper.receive( &msg );
+		if ( res < 0 )
+		{
+			state.SkipWithError( "receive failed" );
+			break;
+		}
+		benchmark::DoNotOptimize( msg.data );
+	}
+	state.SetBytesProcessed( (int64_t) state.iterations() * ( state.range( 0 ) + 8 ) );
+}
+BENCHMARK( BM_gripper_receive )->Arg( 6 )->Arg( 10 )->Arg( 64 );
+
+
+static void BM_script_measure_move( benchmark::State &state )
+{
+	gripper_response info;
+
+	memset( &info, 0, sizeof( info ) );
+	use_memory_interface( script_response( 0xB0 ) );
+
+	for ( auto _ : state )
+	{
+		if ( !script_measure_move( 0, 0.0f, 0.0f, info ) )
+		{
+			state.SkipWithError( "script_measure_move failed" );
+			break;
+		}
+		benchmark::DoNotOptimize( info );
+	}
+}
+BENCHMARK( BM_script_measure_move );
+
+
+/**
+ * Sample log append in the I/O thread, ring of Arg records in a
+ * temporary file (wraps around during the run)
+ */
+
+static void BM_sample_log_append( benchmark::State &state )
+{
+	char path[] = "/tmp/wsg50_benchXXXXXX";
+	int fd = mkstemp( path );
+	if ( fd < 0 )
+	{
+		state.SkipWithError( "mkstemp failed" );
+		return;
+	}
+	close( fd );
+
+	SampleLog log;
+	if ( log.open( path, state.range( 0 ), 0.0 ) != 0 )
+	{
+		unlink( path );
+		state.SkipWithError( "SampleLog::open failed" );
+		return;
+	}
+
+	sample_record record;
+	memset( &record, 0, sizeof( record ) );
+	record.flags = SAMPLE_HAS_CLOCK | SAMPLE_HAS_STATE;
+	record.position = 42.5f;
+
+	for ( auto _ : state )
+	{
+		record.seq++;
+		log.append( record );
+	}
+	state.SetBytesProcessed( state.iterations() * sizeof( sample_record ) );
+
+	log.close();
+	unlink( path );
+}
+BENCHMARK( BM_sample_log_append )->Arg( 4096 )->Arg( 262144 );
+
+
+/**
+ * State estimator: one sample fused at 50 Hz, then Arg predictions as
+ * published by the estimator thread in between
+ */
+
+static void BM_state_estimator( benchmark::State &state )
+{
+	StateEstimator estimator;
+	state_estimate estimate;
+	double t = 0.0;
+	int predictions = state.range( 0 );
+
+	estimator.command( 0.0, 20.0 );
+	for ( auto _ : state )
+	{
+		t += 0.02;
+		estimator.update( t, 20.0 * t, 20.0, true );
+		for ( int i = 1; i <= predictions; i++ )
+			estimator.predict( t + 0.02 * i / predictions, &estimate );
+		benchmark::DoNotOptimize( estimate );
+	}
+	state.SetItemsProcessed( state.iterations() * ( predictions + 1 ) );
+}
+BENCHMARK( BM_state_estimator )->Arg( 0 )->Arg( 10 )->Arg( 20 );
+
+
+/**
+ * Finger sensor data of one sample, both fingers: SIMD path against the
+ * scalar loop
+ */
+template <void ( *decode )( const unsigned char *, float *, int )>
+static void BM_tactile_decode( benchmark::State &state )
+{
+	unsigned char raw[2][TACTILE_BYTES];
+	float volts[2][TACTILE_TAXELS];
+
+	for ( int i = 0; i < TACTILE_BYTES; i++ )
+	{
+		raw[0][i] = (unsigned char) ( i * 37 );
+		raw[1][i] = (unsigned char) ( i & 1 ? i % 16 : 255 - i );
+	}
+	for ( auto _ : state )
+	{
+		benchmark::DoNotOptimize( raw );
+		decode( raw[0], volts[0], TACTILE_TAXELS );
+		decode( raw[1], volts[1], TACTILE_TAXELS );
+		benchmark::DoNotOptimize( volts );
+	}
+	state.SetItemsProcessed( state.iterations() * 2 * TACTILE_TAXELS );
+}
+BENCHMARK_TEMPLATE( BM_tactile_decode, tactile_decode );
+BENCHMARK_TEMPLATE( BM_tactile_decode, tactile_decode_scalar );
+
+
+/**
+ * Calibration of both fingers of one sample: linear models on finger 0,
+ * tables on finger 1. SIMD path against the scalar loop.
+ */
+template <void ( TactileCalibration::*apply )( int, const float *, tactile_map * ) const>
+static void BM_tactile_calibration( benchmark::State &state )
+{
+	char path[] = "/tmp/wsg50_bench_calibrationXXXXXX";
+	int fd = mkstemp( path );
+	if ( fd < 0 )
+	{
+		state.SkipWithError( "mkstemp failed" );
+		return;
+	}
+	const char *text = "threshold 0.5\n0 * linear 0.1 40\n1 * table 0.2 0 1.0 50 2.0 200 3.0 600\n";
+	bool written = write( fd, text, strlen( text ) ) == (ssize_t) strlen( text );
+	close( fd );
+
+	TactileCalibration calibration;
+	std::string error;
+	if ( !written || calibration.load( path, &error ) != 0 )
+	{
+		unlink( path );
+		state.SkipWithError( "calibration not loaded" );
+		return;
+	}
+	unlink( path );
+
+	float volts[TACTILE_TAXELS];
+	tactile_map maps[2];
+	for ( int i = 0; i < TACTILE_TAXELS; i++ )
+		volts[i] = ( i * 37 % 4096 ) * TACTILE_VREF / TACTILE_ADC_RANGE;
+	for ( auto _ : state )
+	{
+		benchmark::DoNotOptimize( volts );
+		( calibration.*apply )( 0, volts, &maps[0] );
+		( calibration.*apply )( 1, volts, &maps[1] );
+		benchmark::DoNotOptimize( maps );
+	}
+	state.SetItemsProcessed( state.iterations() * 2 * TACTILE_TAXELS );
+}
+BENCHMARK_TEMPLATE( BM_tactile_calibration, &TactileCalibration::apply );
+BENCHMARK_TEMPLATE( BM_tactile_calibration, &TactileCalibration::apply_scalar );
+
+
+BENCHMARK_MAIN();
@@ -52,6 +52,8 @@ extern "C" {
 // Global variables
 //------------------------------------------------------------------------
 
+extern const unsigned short CRC_TABLE_CCITT16[256];
+
 
 //------------------------------------------------------------------------
 // Function declaration
@@ -60,6 +62,16 @@ extern "C" {
 unsigned short checksum_update_crc16( unsigned char *data, unsigned int size, unsigned short crc );
 unsigned short checksum_crc16( unsigned char *data, unsigned int size );
 
+/**
+ * Update a CRC16 checksum with a single byte. Inlined variant of
+ * checksum_update_crc16() for byte-wise framing code.
+ */
+
+static inline unsigned short checksum_update_crc16_byte( unsigned char data, unsigned short crc )
+{
+	return CRC_TABLE_CCITT16[ ( crc ^ data ) & 0x00FF ] ^ ( crc >> 8 );
+}
+
 #ifdef __cplusplus
 }
 #endif
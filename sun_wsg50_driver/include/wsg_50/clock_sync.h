@@ -0,0 +1,228 @@
+//======================================================================
+/**
+ *  @file
+ *  clock_sync.h
+ *
+ *  @section clock_sync.h_general General file information
+ *
+ *  @brief
+ *  Sequence tracking and device-to-host clock mapping for the script
+ *  protocol.
+ *
+ *  The measure scripts append a sequence number and the device
+ *  millisecond tick (systimer()) to each 0xB0-0xB2 response. Gaps in the
+ *  sequence are counted as dropped samples, repeated numbers as
+ *  duplicates; a jump backwards (script restarted) starts a new epoch.
+ *
+ *  The device time is mapped to host time by a linear model
+ *    host = device + offset + drift * device
+ *  fitted online by least squares with exponential forgetting
+ *  (CLOCK_FORGETTING, about 1000 samples of memory) against the host
+ *  sampling instants estimated by the timestamp model. The device
+ *  sampling period and its jitter are tracked from consecutive ticks.
+ *
+ *  All host times are monotonic seconds (StateCache::now()).
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section clock_sync.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef CLOCK_SYNC_H_
+#define CLOCK_SYNC_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <mutex>
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define CLOCK_FORGETTING		0.999	// Weight of the past per sample in the fit
+#define CLOCK_MIN_SAMPLES		20		// Samples needed before device times are mapped
+#define CLOCK_PERIOD_GAIN		0.01	// Filter gain of the sampling period and jitter
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef struct
+{
+	unsigned long samples;		// Samples in the current epoch
+	unsigned long dropped;		// Sequence numbers never received
+	unsigned long duplicated;	// Sequence numbers received more than once
+	unsigned int resets;		// Epochs started after the first one
+	double offset;				// host - device at the last sample [s]
+	double drift;				// Device clock drift (1e-6 = 1 ppm)
+	double period;				// Mean device sampling period [s]
+	double jitter;				// Standard deviation of the sampling period [s]
+	double residual;			// Standard deviation of host - mapped device time [s]
+} clock_stats;
+
+
+class ClockSync
+{
+public:
+	ClockSync() : resets_( 0 ), dropped_( 0 ), duplicated_( 0 ) { restart(); }
+
+	ClockSync( const ClockSync & ) = delete;
+	ClockSync & operator=( const ClockSync & ) = delete;
+
+	/**
+	 * Add one sample
+	 *
+	 * @param seq		Sequence number sent by the script
+	 * @param tick		Device millisecond tick sent by the script
+	 * @param host		Estimated host sampling instant [s]
+	 *
+	 * @return Host time of the sample mapped from the device clock, or
+	 *         host if the model has not settled yet
+	 */
+
+	double update( uint32_t seq, uint32_t tick, double host )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		double x, y;
+
+		if ( samples_ > 0 )
+		{
+			uint32_t gap = seq - seq_;
+
+			if ( gap == 0 )
+			{
+				duplicated_++;
+				return map( device_, host );
+			}
+			if ( gap > 0x7FFFFFFFu )
+			{
+				restart();
+				resets_++;
+			}
+			else
+			{
+				uint32_t elapsed = tick - tick_;
+
+				dropped_ += gap - 1;
+				device_ += elapsed / 1000.0;
+
+				// Period and jitter, per sequence step
+				double period = elapsed / 1000.0 / gap;
+				if ( samples_ == 1 ) period_ = period;
+				double diff = period - period_;
+				period_ += CLOCK_PERIOD_GAIN * diff;
+				period_var_ = ( 1.0 - CLOCK_PERIOD_GAIN ) * ( period_var_ + CLOCK_PERIOD_GAIN * diff * diff );
+			}
+		}
+
+		if ( samples_ == 0 )
+		{
+			host0_ = host;
+			device_ = 0.0;
+		}
+		seq_ = seq;
+		tick_ = tick;
+		samples_++;
+
+		// Residual against the model before this sample
+		x = device_;
+		y = host - host0_ - x;
+		if ( samples_ > CLOCK_MIN_SAMPLES )
+		{
+			double r = y - ( offset_ + drift_ * x );
+			res_var_ = CLOCK_FORGETTING * res_var_ + ( 1.0 - CLOCK_FORGETTING ) * r * r;
+		}
+
+		// Exponentially weighted least squares of y = offset + drift * x
+		s_ = CLOCK_FORGETTING * s_ + 1.0;
+		sx_ = CLOCK_FORGETTING * sx_ + x;
+		sy_ = CLOCK_FORGETTING * sy_ + y;
+		sxx_ = CLOCK_FORGETTING * sxx_ + x * x;
+		sxy_ = CLOCK_FORGETTING * sxy_ + x * y;
+
+		double det = s_ * sxx_ - sx_ * sx_;
+		if ( det > 1e-12 )
+		{
+			drift_ = ( s_ * sxy_ - sx_ * sy_ ) / det;
+			offset_ = ( sy_ - drift_ * sx_ ) / s_;
+		}
+		else
+		{
+			drift_ = 0.0;
+			offset_ = sy_ / s_;
+		}
+
+		return map( device_, host );
+	}
+
+	clock_stats stats() const
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		clock_stats s;
+
+		memset( &s, 0, sizeof( s ) );
+		s.samples = samples_;
+		s.dropped = dropped_;
+		s.duplicated = duplicated_;
+		s.resets = resets_;
+		s.offset = host0_ + offset_ + drift_ * device_;
+		s.drift = drift_;
+		s.period = period_;
+		s.jitter = sqrt( period_var_ );
+		s.residual = sqrt( res_var_ );
+
+		return s;
+	}
+
+private:
+	/** \brief Start a new epoch, keeping the drop/duplicate counters */
+	void restart()
+	{
+		samples_ = 0;
+		seq_ = 0; tick_ = 0;
+		host0_ = 0.0; device_ = 0.0;
+		s_ = sx_ = sy_ = sxx_ = sxy_ = 0.0;
+		offset_ = drift_ = 0.0;
+		period_ = period_var_ = res_var_ = 0.0;
+	}
+
+	double map( double device, double host ) const
+	{
+		if ( samples_ < CLOCK_MIN_SAMPLES ) return host;
+		return host0_ + device + offset_ + drift_ * device;
+	}
+
+	mutable std::mutex mutex_;
+	unsigned int resets_;
+	unsigned long dropped_, duplicated_;
+	unsigned long samples_;
+	uint32_t seq_, tick_;
+	double host0_, device_;				// Host time of the epoch start, device time since then [s]
+	double s_, sx_, sy_, sxx_, sxy_;	// Weighted sums of the fit
+	double offset_, drift_;
+	double period_, period_var_, res_var_;
+};
+
+
+//------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------
+
+/** \brief Driver-wide clock model of the script protocol, fed by script_measure_move() */
+ClockSync & clock_sync();
+
+
+#endif /* CLOCK_SYNC_H_ */
@@ -32,6 +32,7 @@
 //------------------------------------------------------------------------
 
 #include "common.h"
+#include "interface.h"
 
 
 //------------------------------------------------------------------------
@@ -48,6 +49,18 @@ extern "C" {
 // Typedefs, enums, structs
 //------------------------------------------------------------------------
 
+// Replacement for the send/receive part of cmd_submit(), same signature
+typedef int ( *cmd_submit_hook_t )( unsigned char id, unsigned char *payload, unsigned int len,
+									bool pending, unsigned char **response, unsigned int *response_len );
+
+// Replacement for cmd_send(), same signature
+typedef int ( *cmd_send_hook_t )( unsigned char id, unsigned char *payload, unsigned int len, bool pending );
+
+// Called after every cmd_submit() with its result (response length, -1 on
+// error); response is the payload if result > 0, else NULL
+typedef void ( *cmd_observer_t )( unsigned char id, const unsigned char *payload, unsigned int len,
+								  int result, const unsigned char *response );
+
 
 //------------------------------------------------------------------------
 // Global variables
@@ -61,6 +74,7 @@ extern "C" {
 int cmd_connect_tcp( const char *addr, unsigned short port );
 int cmd_connect_udp( unsigned short local_port, const char *addr, unsigned short remote_port );
 int cmd_connect_serial( const char *device, unsigned int bitrate );
+int cmd_connect_interface( const interface_t *iface, const void *params );
 
 void cmd_disconnect( void );
 bool cmd_is_connected( void );
@@ -68,6 +82,10 @@ status_t cmd_get_response_status( unsigned char *response );
 
 int cmd_submit( unsigned char id, unsigned char *payload, unsigned int len,
 			    bool pending, unsigned char **response, unsigned int *response_len );
+int cmd_send( unsigned char id, unsigned char *payload, unsigned int len, bool pending );
+void cmd_set_submit_hook( cmd_submit_hook_t hook );
+void cmd_set_send_hook( cmd_send_hook_t hook );
+void cmd_set_observer( cmd_observer_t observer_fn );
 
 
 #ifdef __cplusplus
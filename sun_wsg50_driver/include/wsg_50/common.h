@@ -162,6 +162,8 @@ ip_addr_t str_to_ipaddr( const char *str );
 const char * status_to_str( status_t status );
 void quit( const char *reason );
 const char * getStateValues( unsigned char * b);
+unsigned int stateFlags( const unsigned char *b );
+const char * getStateText( unsigned int flags );
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,145 @@
+//======================================================================
+/**
+ *  @file
+ *  contact_detector.h
+ *
+ *  @section contact_detector.h_general General file information
+ *
+ *  @brief
+ *  Contact detection for velocity commands, evaluated on every sample.
+ *
+ *  While the fingers follow a speed command (closing only, unless
+ *  closing_only is false) a contact is reported when
+ *    - the finger force exceeds finger_threshold (CONTACT_FINGER), or
+ *    - the motor force rose by force_threshold above its level during
+ *      the free motion and the speed collapsed below speed_ratio times
+ *      the commanded speed (CONTACT_FORCE | CONTACT_SPEED), or
+ *    - the speed stayed collapsed for collapse_time (CONTACT_SPEED).
+ *  The first arm_time seconds of a command are ignored: the fingers
+ *  are still accelerating. Forces that are not measured are passed as
+ *  NAN and never detect.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section contact_detector.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef CONTACT_DETECTOR_H_
+#define CONTACT_DETECTOR_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+// Contact sources, ContactDetector::update()
+#define CONTACT_FINGER		0x01	// Finger force above finger_threshold
+#define CONTACT_FORCE		0x02	// Motor force rise
+#define CONTACT_SPEED		0x04	// Speed collapse
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef struct
+{
+	double min_speed;			// Commands below are not watched [mm/s]
+	double arm_time;			// Ignored start of a command [s]
+	double speed_ratio;			// Collapsed below this fraction of the commanded speed
+	double collapse_time;		// Collapse alone detects after this time [s], <= 0 disables
+	double force_threshold;		// Motor force rise [N], <= 0 disables
+	double finger_threshold;	// Finger force [N], <= 0 disables
+	bool closing_only;			// Watch negative (closing) speeds only
+} contact_params;
+
+
+class ContactDetector
+{
+public:
+	ContactDetector()
+	{
+		params_.min_speed = 5.0;
+		params_.arm_time = 0.1;
+		params_.speed_ratio = 0.3;
+		params_.collapse_time = 0.03;
+		params_.force_threshold = 5.0;
+		params_.finger_threshold = 2.0;
+		params_.closing_only = true;
+		reset();
+	}
+
+	void set_params( const contact_params &params ) { params_ = params; reset(); }
+	const contact_params & params() const { return params_; }
+
+	/** \brief Disarm, the next command is watched after arm_time */
+	void reset() { command_ = 0.0; armed_since_ = -1.0; collapsed_since_ = -1.0; baseline_ = NAN; }
+
+	/**
+	 * One sample
+	 *
+	 * @param time			Sampling instant [s]
+	 * @param command		Commanded speed [mm/s], 0 without a speed command
+	 * @param speed			Measured speed [mm/s]
+	 * @param force			Motor force [N], NAN if not measured
+	 * @param finger_force	Finger force [N], NAN if not measured
+	 *
+	 * @return CONTACT_* sources, 0 without contact
+	 */
+	unsigned int update( double time, double command, double speed, double force, double finger_force )
+	{
+		if ( fabs( command ) < params_.min_speed || ( params_.closing_only && command > 0.0 ) )
+		{
+			reset();
+			return 0;
+		}
+		if ( armed_since_ < 0.0 || ( command > 0.0 ) != ( command_ > 0.0 ) )
+		{
+			reset();
+			armed_since_ = time;
+		}
+		command_ = command;
+
+		bool collapsed = speed * command < params_.speed_ratio * command * command;
+		if ( !collapsed ) collapsed_since_ = -1.0;
+		else if ( collapsed_since_ < 0.0 ) collapsed_since_ = time;
+
+		// Force level of the free motion
+		bool rise = !isnan( force ) && !isnan( baseline_ ) && params_.force_threshold > 0.0 &&
+					force - baseline_ > params_.force_threshold;
+		if ( !isnan( force ) && !collapsed && !rise )
+			baseline_ = isnan( baseline_ ) ? force : baseline_ + 0.1 * ( force - baseline_ );
+
+		if ( time - armed_since_ < params_.arm_time ) return 0;
+
+		unsigned int sources = 0;
+		if ( params_.finger_threshold > 0.0 && fabs( finger_force ) > params_.finger_threshold )
+			sources |= CONTACT_FINGER;
+		if ( rise && collapsed )
+			sources |= CONTACT_FORCE | CONTACT_SPEED;
+		else if ( collapsed && params_.collapse_time > 0.0 && time - collapsed_since_ >= params_.collapse_time )
+			sources |= CONTACT_SPEED;
+		return sources;
+	}
+
+private:
+	contact_params params_;
+	double command_;
+	double armed_since_, collapsed_since_;
+	double baseline_;
+};
+
+
+#endif /* CONTACT_DETECTOR_H_ */
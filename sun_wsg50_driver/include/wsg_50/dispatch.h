@@ -0,0 +1,72 @@
+//======================================================================
+/**
+ *  @file
+ *  dispatch.h
+ *
+ *  @section dispatch.h_general General file information
+ *
+ *  @brief
+ *  Response dispatching for a reader thread that owns the interface.
+ *
+ *  In auto update (streaming) mode one thread reads every frame the
+ *  gripper sends. After dispatch_enable(), cmd_submit() no longer reads
+ *  itself: it sends the command and waits until the reader thread hands
+ *  over a frame with the matching command ID via dispatch_deliver().
+ *  Pending responses (E_CMD_PENDING) are handled as in cmd_submit().
+ *
+ *  Commands with different IDs are in flight at the same time, so a STOP
+ *  preempts a running MOVE. Responses of one ID arrive in send order and
+ *  go to the oldest request of that ID, which leaves the queue with its
+ *  final (not pending) response. Commands sent with cmd_send() hold their
+ *  place in the queue too, but their responses stay with the reader
+ *  thread: a MOVE sent by the position topic doesn't complete a waiting
+ *  move service.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section dispatch.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef DISPATCH_H_
+#define DISPATCH_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include "msg.h"
+
+
+//------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------
+
+/**
+ * Route cmd_submit() responses through dispatch_deliver()
+ *
+ * @param timeout	Maximum time to wait for each response frame [s]
+ */
+void dispatch_enable( double timeout );
+
+/** \brief Restore the default cmd_submit(), waiting callers fail */
+void dispatch_disable( void );
+
+/**
+ * Hand a received frame to the command waiting for it
+ *
+ * @param *msg		Received message. If consumed, the payload is owned
+ * 					by the waiting command and msg->data is set to NULL.
+ *
+ * @return true if a cmd_submit() was waiting for this frame; false for
+ * 		   frames nobody waits for and responses to cmd_send()
+ */
+bool dispatch_deliver( msg_t *msg );
+
+
+#endif /* DISPATCH_H_ */
@@ -0,0 +1,66 @@
+//======================================================================
+/**
+ *  @file
+ *  driver.h
+ *
+ *  @section driver.h_general General file information
+ *
+ *  @brief
+ *  Start/stop of the WSG50 ROS driver (driver.cpp), shared by the
+ *  wsg_50_ip_sun node and the driver nodelet. The driver state is
+ *  global, so there can be only one driver per process.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section driver.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef DRIVER_H_
+#define DRIVER_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <ros/ros.h>
+
+
+//------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------
+
+/**
+ * Whether the callbacks may run in several threads: with com_mode
+ * streaming the responses are dispatched by the read thread, so
+ * commands of concurrent callbacks don't mix up their responses.
+ *
+ * @param nh			Private node handle (parameters)
+ */
+
+bool driver_concurrent( ros::NodeHandle &nh );
+
+/**
+ * Read the parameters, connect to the gripper (homing), advertise the
+ * services/topics and start the timers or the read thread. Callbacks
+ * are served by the callback queue of the node handles; in streaming
+ * mode stop, ack and goal_position have their own queue and thread.
+ *
+ * @param nh			Private node handle (parameters, timers)
+ * @param nh_public		Node handle of topics and services
+ *
+ * @return false if the gripper can't be reached
+ */
+
+bool driver_start( ros::NodeHandle &nh, ros::NodeHandle &nh_public );
+
+/** \brief Stop timers and read thread, disconnect from the gripper */
+void driver_stop( void );
+
+
+#endif /* DRIVER_H_ */
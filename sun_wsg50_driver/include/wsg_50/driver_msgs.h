@@ -0,0 +1,188 @@
+//======================================================================
+/**
+ *  @file
+ *  driver_msgs.h
+ *
+ *  @section driver_msgs.h_general General file information
+ *
+ *  @brief
+ *  Preparation and per-cycle filling of the messages published by
+ *  timer_cb() (driver.cpp), shared with the allocation test.
+ *
+ *  The init_*() functions run once per ReusedMessage allocation (see
+ *  msg_reuse.h) and set names, frame ids and vector sizes. The fill_*()
+ *  functions only write values and stamps into that layout, so a reused
+ *  message is filled without heap allocation.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section driver_msgs.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef DRIVER_MSGS_H_
+#define DRIVER_MSGS_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#include "wsg_50/functions.h"
+#include "wsg_50/tactile.h"
+#include "wsg_50/tactile_calibration.h"
+
+#include <ros/time.h>
+#include "sensor_msgs/JointState.h"
+#include "sun_ros_msgs/Float64Stamped.h"
+#include "sun_wsg50_common/Status.h"
+#include "sun_wsg50_common/StatusCompact.h"
+#include "sun_wsg50_common/Tactile.h"
+#include "sun_wsg50_common/TactilePressure.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define GRIPPER_FRAME_ID	"gripper_tool_frame"
+
+
+//------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------
+
+/** \brief One joint, <prefix>gripper_joint, with one position, velocity and effort */
+inline void init_joint_state( sensor_msgs::JointState &msg, const std::string &joint_prefix )
+{
+	msg.header.frame_id = GRIPPER_FRAME_ID;
+	msg.name.push_back( joint_prefix + "gripper_joint" );
+	msg.position.resize( 1 );
+	msg.velocity.resize( 1 );
+	msg.effort.resize( 1 );
+}
+
+
+inline void init_tactile( sun_wsg50_common::Tactile &msg )
+{
+	msg.header.frame_id = GRIPPER_FRAME_ID;
+	msg.rows = TACTILE_ROWS;
+	msg.cols = TACTILE_COLS;
+}
+
+
+inline void init_tactile_pressure( sun_wsg50_common::TactilePressure &msg )
+{
+	msg.header.frame_id = GRIPPER_FRAME_ID;
+	msg.rows = TACTILE_ROWS;
+	msg.cols = TACTILE_COLS;
+}
+
+
+/** \brief status keeps its capacity: no allocation unless the text grows */
+inline void fill_status( sun_wsg50_common::Status &msg, const ros::Time &stamp, const std::string &state_text,
+						 const gripper_response &info, float acc )
+{
+	msg.header.stamp = stamp;
+	msg.status = state_text;
+	msg.width = info.position;
+	msg.speed = info.speed;
+	msg.acc = acc;
+	msg.force = info.f_motor;
+	msg.force_finger0 = info.f_finger0;
+	msg.force_finger1 = info.f_finger1;
+}
+
+
+inline void fill_status_compact( sun_wsg50_common::StatusCompact &msg, const ros::Time &stamp, unsigned int flags,
+								 const gripper_response &info, float acc )
+{
+	msg.header.stamp = stamp;
+	msg.state = flags;
+	msg.width = info.position;
+	msg.speed = info.speed;
+	msg.acc = acc;
+	msg.force = info.f_motor;
+	msg.force_finger0 = info.f_finger0;
+	msg.force_finger1 = info.f_finger1;
+}
+
+
+/** \brief Opening width [m] */
+inline void fill_width( sun_ros_msgs::Float64Stamped &msg, const ros::Time &stamp, const gripper_response &info )
+{
+	msg.header.stamp = stamp;
+	msg.data = info.position / 1000.0;
+}
+
+
+/** \brief Layout of init_joint_state(), [mm] to [m] */
+inline void fill_joint_state( sensor_msgs::JointState &msg, const ros::Time &stamp, const gripper_response &info )
+{
+	msg.header.stamp = stamp;
+	msg.position[0] = info.position / 1000.0;
+	msg.velocity[0] = info.speed / 1000.0;
+	msg.effort[0] = info.f_motor;
+}
+
+
+/** \brief Voltages of the fingers with tactile data, the other finger 0 */
+inline void fill_tactile( sun_wsg50_common::Tactile &msg, const ros::Time &stamp, const gripper_response &info )
+{
+	msg.header.stamp = stamp;
+	msg.fingers = ( info.tact_finger0 ? sun_wsg50_common::Tactile::FINGER0 : 0 ) |
+				  ( info.tact_finger1 ? sun_wsg50_common::Tactile::FINGER1 : 0 );
+	if ( info.tact_finger0 )
+		std::copy( info.v_finger0, info.v_finger0 + TACTILE_TAXELS, msg.voltages.begin() );
+	else
+		std::fill( msg.voltages.begin(), msg.voltages.begin() + TACTILE_TAXELS, 0.0f );
+	if ( info.tact_finger1 )
+		std::copy( info.v_finger1, info.v_finger1 + TACTILE_TAXELS, msg.voltages.begin() + TACTILE_TAXELS );
+	else
+		std::fill( msg.voltages.begin() + TACTILE_TAXELS, msg.voltages.end(), 0.0f );
+}
+
+
+/**
+ * Pressure maps of the calibrated fingers, the other finger 0 (center of
+ * pressure NAN). The grasp force is the mean of two calibrated fingers.
+ */
+inline void fill_tactile_pressure( sun_wsg50_common::TactilePressure &msg, const ros::Time &stamp,
+								   const tactile_map maps[2], const bool calibrated[2] )
+{
+	float grasp_force = 0.0;
+
+	msg.header.stamp = stamp;
+	msg.fingers = ( calibrated[0] ? sun_wsg50_common::TactilePressure::FINGER0 : 0 ) |
+				  ( calibrated[1] ? sun_wsg50_common::TactilePressure::FINGER1 : 0 );
+	for ( int f = 0; f < 2; f++ )
+	{
+		int first = f * TACTILE_TAXELS;
+		if ( calibrated[f] )
+		{
+			std::copy( maps[f].pressure, maps[f].pressure + TACTILE_TAXELS, msg.pressure.begin() + first );
+			msg.force[f] = maps[f].force;
+			msg.cop_x[f] = maps[f].cop_x;
+			msg.cop_y[f] = maps[f].cop_y;
+			grasp_force += maps[f].force;
+		}
+		else
+		{
+			std::fill( msg.pressure.begin() + first, msg.pressure.begin() + first + TACTILE_TAXELS, 0.0f );
+			msg.force[f] = 0.0;
+			msg.cop_x[f] = msg.cop_y[f] = NAN;
+		}
+	}
+	msg.grasp_force = calibrated[0] && calibrated[1] ? grasp_force / 2.0 : grasp_force;
+}
+
+
+#endif /* DRIVER_MSGS_H_ */
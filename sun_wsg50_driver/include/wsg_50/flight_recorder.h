@@ -0,0 +1,225 @@
+//======================================================================
+/**
+ *  @file
+ *  flight_recorder.h
+ *
+ *  @section flight_recorder.h_general General file information
+ *
+ *  @brief
+ *  In-memory ring of the last samples and command exchanges.
+ *
+ *  Every decoded sample (sample_record, as in the sample log) and every
+ *  command exchange (command_record, see cmd_set_observer()) is kept in
+ *  a fixed-size ring; nothing is allocated after configure(). snapshot()
+ *  copies the records of the last 'duration' seconds, e.g. to dump them
+ *  after a failed grasp.
+ *
+ *  trigger() arms a dump for 'post_trigger' seconds later, so the dump
+ *  also shows what followed the fault, and ignores further triggers for
+ *  'holdoff' seconds. due() reports the armed dump once it is time.
+ *  write() stores a snapshot as a sample log (wsg50_log_convert) and a
+ *  CSV file of the commands.
+ *
+ *  All functions are thread safe: samples, commands and triggers come
+ *  from the I/O loop, the service threads and the reader thread.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section flight_recorder.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef FLIGHT_RECORDER_H_
+#define FLIGHT_RECORDER_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "sample_log.h"
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef struct
+{
+	double time;				// Monotonic time the exchange ended [s]
+	unsigned char id;			// Command ID
+	unsigned int len;			// Payload length
+	int result;					// Response length, -1 on error
+	unsigned short status;		// Response status, E_CMD_FAILED without response
+	unsigned char payload[16];	// First bytes of the payload
+} command_record;
+
+
+template <class T>
+class RecordRing
+{
+public:
+	RecordRing() : next_( 0 ), count_( 0 ) {}
+
+	void resize( size_t capacity ) { records_.assign( capacity, T() ); next_ = 0; count_ = 0; }
+
+	void push( const T &record )
+	{
+		if ( records_.empty() ) return;
+		records_[next_] = record;
+		next_ = ( next_ + 1 ) % records_.size();
+		if ( count_ < records_.size() ) count_++;
+	}
+
+	/** \brief Append the records with time(record) >= since, oldest first */
+	template <class Time>
+	void copy_since( double since, Time time, std::vector<T> &out ) const
+	{
+		size_t first = ( next_ + records_.size() - count_ ) % ( records_.empty() ? 1 : records_.size() );
+		for ( size_t i = 0; i < count_; i++ )
+		{
+			const T &record = records_[( first + i ) % records_.size()];
+			if ( time( record ) >= since ) out.push_back( record );
+		}
+	}
+
+private:
+	std::vector<T> records_;
+	size_t next_, count_;
+};
+
+
+class FlightRecorder
+{
+public:
+	FlightRecorder() : duration_( 10.0 ), post_trigger_( 0.5 ), holdoff_( 5.0 ),
+					   armed_( false ), due_at_( 0.0 ), last_trigger_( -1.0E9 ) {}
+
+	/**
+	 * Allocate the rings
+	 *
+	 * @param duration		Time span kept [s]
+	 * @param samples		Ring size for samples
+	 * @param commands		Ring size for command exchanges
+	 * @param post_trigger	Delay of a triggered dump [s]
+	 * @param holdoff		Min. time between two triggers [s]
+	 */
+	void configure( double duration, size_t samples, size_t commands, double post_trigger, double holdoff )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		duration_ = duration;
+		post_trigger_ = post_trigger;
+		holdoff_ = holdoff;
+		samples_.resize( samples );
+		commands_.resize( commands );
+		armed_ = false;
+		last_trigger_ = -1.0E9;
+	}
+
+	void sample( const sample_record &record )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		samples_.push( record );
+	}
+
+	void command( const command_record &record )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		commands_.push( record );
+	}
+
+	/** \brief Copy the records of the last duration seconds before now, oldest first */
+	void snapshot( double now, std::vector<sample_record> &samples, std::vector<command_record> &commands ) const
+	{
+		samples.clear();
+		commands.clear();
+		std::lock_guard<std::mutex> lock( mutex_ );
+		samples_.copy_since( now - duration_, sample_time, samples );
+		commands_.copy_since( now - duration_, command_time, commands );
+	}
+
+	/**
+	 * Arm a dump post_trigger seconds from now
+	 *
+	 * @return false if a dump is armed already or within holdoff of the last trigger
+	 */
+	bool trigger( double now, const std::string &reason )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		if ( armed_ || now - last_trigger_ < holdoff_ ) return false;
+		armed_ = true;
+		due_at_ = now + post_trigger_;
+		last_trigger_ = now;
+		reason_ = reason;
+		return true;
+	}
+
+	/** \brief true once when the armed dump is due, with the reason of its trigger */
+	bool due( double now, std::string &reason )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		if ( !armed_ || now < due_at_ ) return false;
+		armed_ = false;
+		reason = reason_;
+		return true;
+	}
+
+	/**
+	 * Write a snapshot to base.wlog (sample log) and base_commands.csv
+	 *
+	 * @param files		Receives the names of the files written
+	 *
+	 * @return 0 on success, -1 otherwise (errno is set)
+	 */
+	static int write( const std::string &base, const std::vector<sample_record> &samples,
+					  const std::vector<command_record> &commands, double created, std::vector<std::string> &files )
+	{
+		files.clear();
+
+		SampleLog log;
+		std::string log_path = base + ".wlog";
+		if ( log.open( log_path.c_str(), samples.empty() ? 1 : samples.size(), created ) != 0 ) return -1;
+		for ( size_t i = 0; i < samples.size(); i++ ) log.append( samples[i] );
+		log.close();
+		files.push_back( log_path );
+
+		std::string csv_path = base + "_commands.csv";
+		FILE *csv = fopen( csv_path.c_str(), "w" );
+		if ( !csv ) return -1;
+		fprintf( csv, "time,id,len,result,status,payload\n" );
+		for ( size_t i = 0; i < commands.size(); i++ )
+		{
+			const command_record &c = commands[i];
+			fprintf( csv, "%.6f,0x%02X,%u,%d,%u,", c.time, c.id, c.len, c.result, c.status );
+			for ( unsigned int k = 0; k < c.len && k < sizeof( c.payload ); k++ ) fprintf( csv, "%02X", c.payload[k] );
+			fprintf( csv, "\n" );
+		}
+		if ( fclose( csv ) != 0 ) return -1;
+		files.push_back( csv_path );
+		return 0;
+	}
+
+private:
+	static double sample_time( const sample_record &record ) { return record.received; }
+	static double command_time( const command_record &record ) { return record.time; }
+
+	mutable std::mutex mutex_;
+	RecordRing<sample_record> samples_;
+	RecordRing<command_record> commands_;
+	double duration_, post_trigger_, holdoff_;
+	bool armed_;
+	double due_at_, last_trigger_;
+	std::string reason_;
+};
+
+
+#endif /* FLIGHT_RECORDER_H_ */
@@ -0,0 +1,161 @@
+//======================================================================
+/**
+ *  @file
+ *  force_loop.h
+ *
+ *  @section force_loop.h_general General file information
+ *
+ *  @brief
+ *  Grasp force control stage for the driver's I/O loop.
+ *
+ *  The force_reference_filt -> force_control -> status_monitoring
+ *  pipeline of sun_wsg50_control in one function, evaluated in the same
+ *  cycle the speed command is sent to the gripper:
+ *    1. the reference is replaced by max_force while the measure
+ *       exceeds max_force, then low-pass filtered (cut_freq)
+ *    2. speed = -control_gain * (inv_stiff(|ref|) - |inv_stiff(measure)|)
+ *       with the linear (f / stiff_1) or square root
+ *       (sqrt(|f| / stiff_2)) contact model; zero while the measure
+ *       exceeds 2 * max_force and the reference is even higher
+ *    3. zero if the command would leave [width_min, width_max]
+ *    4. zero if the result or the opening is NaN or inf
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section force_loop.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef FORCE_LOOP_H_
+#define FORCE_LOOP_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef enum
+{
+	FORCE_OK = 0,
+	FORCE_OVERLOAD,			// Measure above 2 * max_force, reference higher
+	FORCE_WIDTH_LIMIT,		// Command would leave [width_min, width_max]
+	FORCE_INVALID			// NaN or inf
+} force_loop_state_t;
+
+
+typedef struct
+{
+	double control_gain;	// [1/s]
+	double max_force;		// [N]
+	double stiff_1;			// Linear contact model [N/m]
+	double stiff_2;			// Square root contact model [N/m^2]
+	bool linear_model;
+	double cut_freq;		// Reference filter cut-off [Hz], <= 0 disables the filter
+	double width_min;		// [m]
+	double width_max;		// [m]
+} force_loop_params;
+
+
+class ForceLoop
+{
+public:
+	/** \brief Defaults of wsg50_control.launch */
+	ForceLoop() : reference_( 0.0 ), state_( FORCE_OK )
+	{
+		params_.control_gain = 5.0;
+		params_.max_force = 10.0;
+		params_.stiff_1 = 6.4346095511E+03;
+		params_.stiff_2 = 4.8444986930E+06;
+		params_.linear_model = false;
+		params_.cut_freq = 50.0;
+		params_.width_min = 0.020;
+		params_.width_max = 0.108;
+	}
+
+	void set_params( const force_loop_params &params ) { params_ = params; }
+	const force_loop_params & params() const { return params_; }
+
+	/** \brief Restart the reference filter from a value [N] */
+	void reset( double reference = 0.0 ) { reference_ = reference; state_ = FORCE_OK; }
+
+	/**
+	 * One control cycle
+	 *
+	 * @param reference		Force reference [N]
+	 * @param measure		Measured grasp force [N]
+	 * @param width			Current opening [m]
+	 * @param dt			Time since the last cycle [s]
+	 *
+	 * @return Speed command [mm/s], finite
+	 */
+
+	double update( double reference, double measure, double width, double dt )
+	{
+		double speed;
+
+		// Reference filter
+		if ( fabs( measure ) > params_.max_force ) reference = params_.max_force;
+		if ( params_.cut_freq > 0.0 && dt > 0.0 && isfinite( reference_ ) )
+			reference_ += ( 1.0 - exp( -2.0 * M_PI * params_.cut_freq * dt ) ) * ( reference - reference_ );
+		else
+			reference_ = reference;
+
+		// Control law
+		state_ = FORCE_OK;
+		if ( fabs( measure ) > 2.0 * params_.max_force && fabs( reference_ ) > fabs( measure ) )
+		{
+			state_ = FORCE_OVERLOAD;
+			speed = 0.0;
+		}
+		else
+		{
+			speed = -params_.control_gain * ( inv_stiff( fabs( reference_ ) ) - fabs( inv_stiff( measure ) ) );
+			speed *= 1.0E3;		// m/s to mm/s
+		}
+
+		// Width monitoring
+		if ( ( width >= params_.width_max && speed > 0.0 ) || ( width <= params_.width_min && speed < 0.0 ) )
+		{
+			state_ = FORCE_WIDTH_LIMIT;
+			speed = 0.0;
+		}
+
+		// NaN/inf guard, also keeps the filter usable; an unknown opening cannot be monitored
+		if ( !isfinite( speed ) || !isfinite( width ) )
+		{
+			state_ = FORCE_INVALID;
+			if ( !isfinite( reference_ ) ) reference_ = 0.0;
+			speed = 0.0;
+		}
+
+		return speed;
+	}
+
+	double reference() const { return reference_; }
+	force_loop_state_t state() const { return state_; }
+
+private:
+	double inv_stiff( double f ) const
+	{
+		if ( params_.linear_model ) return f / params_.stiff_1;
+		return sqrt( fabs( f ) / params_.stiff_2 );
+	}
+
+	force_loop_params params_;
+	double reference_;		// Filtered reference [N]
+	force_loop_state_t state_;
+};
+
+
+#endif /* FORCE_LOOP_H_ */
@@ -27,7 +27,7 @@
 #ifndef FUNCTIONS_H_
 #define FUNCTIONS_H_
 
- #include <string>
+#include "common.h"
 
 //------------------------------------------------------------------------
 // Includes
@@ -52,9 +52,11 @@ typedef struct {
 	bool ismoving;
 	float position, speed;
 	float f_motor, f_finger0, f_finger1;
-	std::string state_text;
+	const char *state_text;		// Owned by getStateValues(), may be NULL
 	bool tact_finger0,tact_finger1;
 	float v_finger0[25],v_finger1[25];
+	bool has_clock;				// Script response carried seq and device_ms
+	unsigned int seq, device_ms;
 } gripper_response;
 
 //------------------------------------------------------------------------
@@ -74,15 +76,20 @@ int stop( bool ignore_response = false );
 int grasp( float objWidth, float speed );
 int release( float width, float speed );
 int ack_fault( void );
+status_t command_status( void );
 
 int setAcceleration( float acc );
 int setGraspingForceLimit( float force );
 
 const char * systemState( void );
+int systemStateFlags( unsigned int *flags, int auto_update = 0 );
 int graspingState( void );
 float getOpening(int auto_update = 0);
 float getForce(int auto_update = 0);
 float getSpeed(int auto_update = 0);
+float getOpeningCached(double max_age);
+float getForceCached(double max_age);
+float getSpeedCached(double max_age);
 int getAcceleration( void );
 int getGraspingForceLimit( void );
 
@@ -0,0 +1,294 @@
+//======================================================================
+/**
+ *  @file
+ *  gripper.h
+ *
+ *  @section gripper.h_general General file information
+ *
+ *  @brief
+ *  Header-only command layer with the transport as template parameter.
+ *
+ *  Gripper<Transport> implements the same framing as msg.c/cmd.c
+ *  (preamble, id, length, payload, CRC16) but calls the transport
+ *  directly, so the compiler can inline framing, checksum and socket
+ *  calls into one path. Receive buffers are owned by the object and
+ *  reused, no allocation is done per frame once the buffers have grown
+ *  to the largest message seen.
+ *
+ *  The C API in msg.h/cmd.h is a thin wrapper around
+ *  Gripper<InterfaceTransport> and stays source compatible.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section gripper.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef GRIPPER_H_
+#define GRIPPER_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "common.h"
+#include "checksum.h"
+#include "msg.h"
+#include "transport.h"
+#include "trace.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define GRIPPER_HEADER_LEN			( MSG_PREAMBLE_LEN + 3 )	// Preamble, command id, 2 bytes payload length
+#define GRIPPER_CRC_PREAMBLE		0x50f5						// Checksum over preamble (0xaa 0xaa 0xaa)
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+template <class Transport>
+class Gripper
+{
+public:
+	Gripper() : sent_at_( 0.0 ), received_at_( 0.0 ), crc_errors_( 0 ) {}
+
+	Gripper( const Gripper & ) = delete;
+	Gripper & operator=( const Gripper & ) = delete;
+
+	Transport & transport() { return transport_; }
+
+	void close() { transport_.close(); }
+
+	/** \brief Monotonic time [s] when the last frame started to be written */
+	double sent_at() const { return sent_at_.load( std::memory_order_relaxed ); }
+
+	/** \brief Monotonic time [s] when the header of the last frame was received */
+	double received_at() const { return received_at_.load( std::memory_order_relaxed ); }
+
+	/** \brief Frames dropped because of a checksum error */
+	unsigned long crc_errors() const { return crc_errors_.load( std::memory_order_relaxed ); }
+
+	static double now()
+	{
+		return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+	}
+
+
+	/**
+	 * Send command
+	 *
+	 * @param id		Command ID
+	 * @param *payload	Payload data
+	 * @param len		Payload length
+	 *
+	 * @return Number of bytes sent, including header and checksum. -1 on error.
+	 */
+
+	int send( unsigned char id, const unsigned char *payload, unsigned int len )
+	{
+		unsigned int i, size = GRIPPER_HEADER_LEN + len + 2;
+		unsigned short crc = 0xffff;
+		unsigned char *p;
+
+		if ( tx_.size() < size ) tx_.resize( size );
+		p = &tx_[0];
+
+		for ( i = 0; i < MSG_PREAMBLE_LEN; i++ ) p[i] = MSG_PREAMBLE_BYTE;
+		p[MSG_PREAMBLE_LEN] = id;
+		p[MSG_PREAMBLE_LEN + 1] = lo( len );
+		p[MSG_PREAMBLE_LEN + 2] = hi( len );
+		if ( len > 0 ) memcpy( p + GRIPPER_HEADER_LEN, payload, len );
+
+		for ( i = 0; i < GRIPPER_HEADER_LEN + len; i++ ) crc = checksum_update_crc16_byte( p[i], crc );
+		p[GRIPPER_HEADER_LEN + len] = lo( crc );
+		p[GRIPPER_HEADER_LEN + len + 1] = hi( crc );
+
+		WSG50_TRACE2( frame_send, id, len );
+		sent_at_.store( now(), std::memory_order_relaxed );
+		if ( !write_all( p, size ) ) return -1;
+		WSG50_TRACE2( frame_sent, id, len );
+
+		return (int) size;
+	}
+
+
+	/**
+	 * Receive message
+	 *
+	 * The payload stays in the internal receive buffer, msg->data is
+	 * valid until the next call of receive() or submit().
+	 *
+	 * @param *msg		Message struct to fill
+	 *
+	 * @return Overall number of bytes received, including header and checksum. -1 on error.
+	 */
+
+	int receive( msg_t *msg )
+	{
+		unsigned char header[GRIPPER_HEADER_LEN];
+		unsigned short crc = GRIPPER_CRC_PREAMBLE;
+		unsigned int i, len;
+
+		// Read preamble and header at once, slide byte-wise until synced.
+		// Syncing is necessary for compatibility with serial interface.
+		if ( !read_exact( header, GRIPPER_HEADER_LEN ) ) return -1;
+		while ( header[0] != MSG_PREAMBLE_BYTE || header[1] != MSG_PREAMBLE_BYTE || header[2] != MSG_PREAMBLE_BYTE )
+		{
+			WSG50_TRACE1( frame_resync, header[0] );
+			memmove( header, header + 1, GRIPPER_HEADER_LEN - 1 );
+			if ( !read_exact( &header[GRIPPER_HEADER_LEN - 1], 1 ) ) return -1;
+		}
+
+		received_at_.store( now(), std::memory_order_relaxed );
+		for ( i = MSG_PREAMBLE_LEN; i < GRIPPER_HEADER_LEN; i++ ) crc = checksum_update_crc16_byte( header[i], crc );
+
+		len = make_short( header[MSG_PREAMBLE_LEN + 1], header[MSG_PREAMBLE_LEN + 2] );
+		WSG50_TRACE2( frame_rx_header, header[MSG_PREAMBLE_LEN], len );
+
+		// Read payload and checksum
+		if ( rx_.size() < len + 2 ) rx_.resize( len + 2 );
+		if ( !read_exact( &rx_[0], len + 2 ) )
+		{
+			fprintf( stderr, "Not enough data (expected %d)\n", len + 2 );
+			return -1;
+		}
+
+		for ( i = 0; i < len + 2; i++ ) crc = checksum_update_crc16_byte( rx_[i], crc );
+		if ( crc != 0 )
+		{
+			WSG50_TRACE2( frame_crc_fail, header[MSG_PREAMBLE_LEN], len );
+			crc_errors_.fetch_add( 1, std::memory_order_relaxed );
+			fprintf( stderr, "Checksum error\n" );
+			return -1;
+		}
+
+		msg->id = header[MSG_PREAMBLE_LEN];
+		msg->len = len;
+		msg->data = &rx_[0];
+		WSG50_TRACE2( frame_complete, msg->id, len );
+
+		return (int) len + 8;
+	}
+
+
+	/**
+	 * Send command and wait for answer
+	 *
+	 * @param id				Command ID
+	 * @param *payload			Payload data
+	 * @param len				Payload length
+	 * @param pending			Flag indicating whether CMD_PENDING
+	 * 							is allowed return status
+	 * @param **response		Set to the response payload, owned by the object
+	 * @param *response_len		Set to the response payload length
+	 *
+	 * @return Number of bytes received. -1 on error.
+	 */
+
+	int submit( unsigned char id, const unsigned char *payload, unsigned int len,
+				bool pending, unsigned char **response, unsigned int *response_len )
+	{
+		msg_t msg;
+		status_t status = E_SUCCESS;
+
+		WSG50_TRACE2( cmd_start, id, len );
+		if ( send( id, payload, len ) < 0 )
+		{
+			fprintf( stderr, "Message send failed\n" );
+			return -1;
+		}
+
+		// Receive response. Repeat if pending.
+		do
+		{
+			if ( receive( &msg ) < 0 )
+			{
+				fprintf( stderr, "Message receive failed\n" );
+				return -1;
+			}
+
+			if ( msg.id != id )
+			{
+				fprintf( stderr, "Response ID (%2x) does not match submitted command ID (%2x)\n", msg.id, id );
+				return -1;
+			}
+
+			if ( pending )
+			{
+				if ( msg.len < 2 )
+				{
+					fprintf( stderr, "No status code received\n" );
+					return -1;
+				}
+				status = (status_t) make_short( msg.data[0], msg.data[1] );
+				if ( status == E_CMD_PENDING ) WSG50_TRACE1( cmd_pending, id );
+			}
+		}
+		while ( pending && status == E_CMD_PENDING );
+
+		WSG50_TRACE3( cmd_complete, id, pending ? (int) status : 0, msg.len );
+		*response_len = msg.len;
+		*response = msg.len > 0 ? msg.data : 0;
+
+		return (int) msg.len;
+	}
+
+private:
+	bool read_exact( unsigned char *buf, unsigned int len )
+	{
+		int res;
+
+		while ( len > 0 )
+		{
+			res = transport_.read( buf, len );
+			if ( res <= 0 ) return false;
+			buf += res;
+			len -= (unsigned int) res;
+		}
+		return true;
+	}
+
+	bool write_all( const unsigned char *buf, unsigned int len )
+	{
+		int res;
+
+		while ( len > 0 )
+		{
+			res = transport_.write( buf, len );
+			if ( res <= 0 ) return false;
+			buf += res;
+			len -= (unsigned int) res;
+		}
+		return true;
+	}
+
+	Transport transport_;
+	std::atomic<double> sent_at_, received_at_;		// Written by the sending and the receiving thread
+	std::atomic<unsigned long> crc_errors_;
+	std::vector<unsigned char> tx_;
+	std::vector<unsigned char> rx_;
+};
+
+
+typedef Gripper<TcpTransport> TcpGripper;
+typedef Gripper<UdpTransport> UdpGripper;
+typedef Gripper<SerialTransport> SerialGripper;
+typedef Gripper<SimTransport> SimGripper;
+
+
+#endif /* GRIPPER_H_ */
@@ -0,0 +1,107 @@
+//======================================================================
+/**
+ *  @file
+ *  mailbox.h
+ *
+ *  @section mailbox.h_general General file information
+ *
+ *  @brief
+ *  Latest-value-wins command mailbox.
+ *
+ *  Setpoints from topics are posted into the mailbox and taken by the
+ *  loop that talks to the gripper, once per exchange. A setpoint that
+ *  is overwritten before it was taken is counted as coalesced, so fast
+ *  publishers can't queue up more commands than the link can carry.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section mailbox.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef MAILBOX_H_
+#define MAILBOX_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <mutex>
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef struct
+{
+	unsigned long posted;		// Values posted
+	unsigned long taken;		// Values taken (sent to the gripper)
+	unsigned long coalesced;	// Values overwritten before they were taken
+} mailbox_stats;
+
+
+template <class T>
+class Mailbox
+{
+public:
+	Mailbox() : value_(), full_( false ), stats_() {}
+
+	Mailbox( const Mailbox & ) = delete;
+	Mailbox & operator=( const Mailbox & ) = delete;
+
+	void post( const T &value )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+
+		if ( full_ ) stats_.coalesced++;
+		value_ = value;
+		full_ = true;
+		stats_.posted++;
+	}
+
+	/**
+	 * Take the latest value
+	 *
+	 * @param *value	Set to the latest value, if any
+	 *
+	 * @return true if a value was posted since the last take()
+	 */
+
+	bool take( T *value )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+
+		if ( !full_ ) return false;
+		*value = value_;
+		full_ = false;
+		stats_.taken++;
+		return true;
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		full_ = false;
+	}
+
+	mailbox_stats stats() const
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		return stats_;
+	}
+
+private:
+	mutable std::mutex mutex_;
+	T value_;
+	bool full_;
+	mailbox_stats stats_;
+};
+
+
+#endif /* MAILBOX_H_ */
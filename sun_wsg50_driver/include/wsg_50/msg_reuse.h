@@ -0,0 +1,85 @@
+//======================================================================
+/**
+ *  @file
+ *  msg_reuse.h
+ *
+ *  @section msg_reuse.h_general General file information
+ *
+ *  @brief
+ *  Message allocated once and reused on every publish cycle.
+ *
+ *  Published by pointer, a message is passed to the subscribers in the
+ *  same process (nodelet manager) without copy, and may still be in
+ *  their queues when the next cycle starts. So the message is only
+ *  reused once the owner holds the last reference; otherwise a new one
+ *  is allocated and prepared by the init function. Fields set by init
+ *  (names, frame ids, vector sizes) are left untouched per cycle, only
+ *  values and stamps are written.
+ *
+ *  Ptr is boost::shared_ptr or std::shared_ptr of the message type.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section msg_reuse.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef MSG_REUSE_H_
+#define MSG_REUSE_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <functional>
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+template <class Ptr>
+class ReusedMessage
+{
+public:
+	typedef typename Ptr::element_type Msg;
+	typedef std::function<void( Msg & )> Init;
+
+	ReusedMessage() : allocations_( 0 ) {}
+	explicit ReusedMessage( const Init &init ) : init_( init ), allocations_( 0 ) {}
+
+	/** \brief Set the function preparing new messages, drops the current one */
+	void set_init( const Init &init )
+	{
+		init_ = init;
+		msg_.reset();
+	}
+
+	/** \brief Message to fill and publish: the previous one if nobody else holds it, else a new one */
+	const Ptr & get()
+	{
+		if ( !msg_ || msg_.use_count() > 1 )
+		{
+			msg_.reset( new Msg() );
+			if ( init_ ) init_( *msg_ );
+			allocations_++;
+		}
+		return msg_;
+	}
+
+	/** \brief Messages allocated so far, 1 if the message was always reused */
+	unsigned long allocations() const { return allocations_; }
+
+private:
+	Ptr msg_;
+	Init init_;
+	unsigned long allocations_;
+};
+
+
+#endif /* MSG_REUSE_H_ */
@@ -0,0 +1,117 @@
+//======================================================================
+/**
+ *  @file
+ *  publish_filter.h
+ *
+ *  @section publish_filter.h_general General file information
+ *
+ *  @brief
+ *  Decides per cycle whether a state topic is published.
+ *
+ *  The device loop may run much faster than the consumers of a topic
+ *  need. A topic is published on every decimation-th cycle and, if a
+ *  deadband is set, only when the opening or the force moved by more
+ *  than the deadband since the last published message, or the system
+ *  state changed. max_period forces a message while nothing changes, so
+ *  late subscribers and watchdogs still see the topic. Subscriber
+ *  counts are checked by the caller, before the message is filled.
+ *
+ *  Defaults publish every cycle.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section publish_filter.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef PUBLISH_FILTER_H_
+#define PUBLISH_FILTER_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef struct
+{
+	int decimation;			// Publish every n-th cycle, <= 1 every cycle
+	double width_deadband;	// [mm], <= 0 disables
+	double force_deadband;	// [N], <= 0 disables
+	double max_period;		// With a deadband: max. time without a message [s], <= 0 disables
+} publish_filter_params;
+
+
+class PublishFilter
+{
+public:
+	PublishFilter() { params_.decimation = 1; params_.width_deadband = 0.0; params_.force_deadband = 0.0; params_.max_period = 0.0; reset(); }
+
+	void set_params( const publish_filter_params &params ) { params_ = params; reset(); }
+	const publish_filter_params & params() const { return params_; }
+
+	/** \brief Next call publishes */
+	void reset() { cycle_ = 0; published_ = false; skipped_ = 0; }
+
+	/**
+	 * One cycle of the loop
+	 *
+	 * @param now		Monotonic time [s]
+	 * @param width		Opening [mm]
+	 * @param force		Force [N]
+	 * @param state		System state bitmask, any change publishes
+	 *
+	 * @return true if the message has to be published
+	 */
+
+	bool update( double now, double width, double force, unsigned int state = 0 )
+	{
+		bool due = true;
+
+		if ( params_.decimation > 1 && cycle_++ % params_.decimation != 0 )
+			due = false;
+		else if ( published_ && state == state_ && ( params_.width_deadband > 0.0 || params_.force_deadband > 0.0 ) )
+		{
+			due = ( params_.width_deadband > 0.0 && !( fabs( width - width_ ) <= params_.width_deadband ) )
+				|| ( params_.force_deadband > 0.0 && !( fabs( force - force_ ) <= params_.force_deadband ) )
+				|| ( params_.max_period > 0.0 && now - published_at_ >= params_.max_period );
+		}
+
+		if ( !due )
+		{
+			skipped_++;
+			return false;
+		}
+		published_ = true;
+		published_at_ = now;
+		width_ = width;
+		force_ = force;
+		state_ = state;
+		return true;
+	}
+
+	/** \brief Cycles not published since the last reset */
+	unsigned long skipped() const { return skipped_; }
+
+private:
+	publish_filter_params params_;
+	unsigned long cycle_;
+	bool published_;
+	double published_at_;
+	double width_, force_;		// Last published values
+	unsigned int state_;
+	unsigned long skipped_;
+};
+
+
+#endif /* PUBLISH_FILTER_H_ */
@@ -0,0 +1,149 @@
+//======================================================================
+/**
+ *  @file
+ *  rate_controller.h
+ *
+ *  @section rate_controller.h_general General file information
+ *
+ *  @brief
+ *  Adaptive loop period from the measured exchange round trip time.
+ *
+ *  The round trip time of each exchange is filtered like the TCP
+ *  retransmission timer (smoothed RTT and RTT variation, RFC 6298).
+ *  The sustainable period is srtt + 4 * rttvar plus a safety margin,
+ *  clamped to [1/max_rate, 1/min_rate]. The period is only changed when
+ *  it differs from the current one by more than the hysteresis. It is
+ *  increased at once (also when an exchange overruns the period), but
+ *  only decreased after RATE_SETTLE_SAMPLES consecutive samples agree.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section rate_controller.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef RATE_CONTROLLER_H_
+#define RATE_CONTROLLER_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define RATE_SETTLE_SAMPLES		10		// Samples needed before the rate is increased
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+class RateController
+{
+public:
+	/**
+	 * @param rate			Initial rate [Hz]
+	 * @param min_rate		Lowest rate [Hz]
+	 * @param max_rate		Highest rate [Hz]
+	 * @param margin		Safety margin on top of the RTT estimate (0.2 = 20%)
+	 * @param hysteresis	Relative change needed before the period is adapted
+	 */
+
+	RateController( double rate = 10.0, double min_rate = 1.0, double max_rate = 500.0,
+					double margin = 0.2, double hysteresis = 0.1 )
+		: min_period_( 1.0 / max_rate ), max_period_( 1.0 / min_rate ),
+		  margin_( margin ), hysteresis_( hysteresis ),
+		  period_( clamp( 1.0 / rate ) ), srtt_( 0.0 ), rttvar_( 0.0 ),
+		  samples_( 0 ), settle_( 0 ), overruns_( 0 ) {}
+
+	/**
+	 * Add one measurement
+	 *
+	 * @param rtt			Round trip time of the exchange(s) of one cycle [s]
+	 * @param duration		Duration of the whole cycle [s], used for overrun detection
+	 *
+	 * @return true if the period was changed
+	 */
+
+	bool update( double rtt, double duration )
+	{
+		double target;
+
+		if ( samples_++ == 0 )
+		{
+			srtt_ = rtt;
+			rttvar_ = rtt / 2.0;
+		}
+		else
+		{
+			rttvar_ = 0.75 * rttvar_ + 0.25 * fabs( srtt_ - rtt );
+			srtt_ = 0.875 * srtt_ + 0.125 * rtt;
+		}
+
+		// Overrun: back off at once, at least to what this cycle needed
+		if ( duration > period_ )
+		{
+			overruns_++;
+			target = clamp( fmax( duration, estimate() ) * ( 1.0 + margin_ ) );
+			settle_ = 0;
+			if ( target > period_ )
+			{
+				period_ = target;
+				return true;
+			}
+			return false;
+		}
+
+		target = clamp( estimate() * ( 1.0 + margin_ ) );
+		if ( target > period_ * ( 1.0 + hysteresis_ ) )
+		{
+			period_ = target;
+			settle_ = 0;
+			return true;
+		}
+		if ( target < period_ * ( 1.0 - hysteresis_ ) )
+		{
+			if ( ++settle_ < RATE_SETTLE_SAMPLES ) return false;
+			period_ = target;
+			settle_ = 0;
+			return true;
+		}
+		settle_ = 0;
+		return false;
+	}
+
+	double period() const { return period_; }
+	double rate() const { return 1.0 / period_; }
+	double srtt() const { return srtt_; }
+	double rttvar() const { return rttvar_; }
+	unsigned long overruns() const { return overruns_; }
+
+private:
+	double estimate() const { return srtt_ + 4.0 * rttvar_; }
+
+	double clamp( double period ) const
+	{
+		return fmin( fmax( period, min_period_ ), max_period_ );
+	}
+
+	double min_period_, max_period_;
+	double margin_, hysteresis_;
+	double period_;
+	double srtt_, rttvar_;
+	unsigned long samples_;
+	unsigned int settle_;
+	unsigned long overruns_;
+};
+
+
+#endif /* RATE_CONTROLLER_H_ */
@@ -0,0 +1,152 @@
+//======================================================================
+/**
+ *  @file
+ *  sample_log.h
+ *
+ *  @section sample_log.h_general General file information
+ *
+ *  @brief
+ *  Binary log of every device sample in a memory-mapped ring file.
+ *
+ *  The file is a sample_log_header followed by 'capacity' fixed-size
+ *  sample_record slots, written in host byte order. append() copies the
+ *  record into slot (n - 1) % capacity of the mapping: no lock, no
+ *  system call, so it can run in the I/O thread. The pages are mapped
+ *  shared and prefaulted; the kernel writes them back, so the records
+ *  also survive a crash of the driver. When the ring is full the oldest
+ *  records are overwritten.
+ *
+ *  There is one writer. A slot's index is cleared before the record is
+ *  written and set (release) after it, then the header count is
+ *  advanced: readers take the slots with index > 0, in index order, and
+ *  skip a slot caught while it was being written.
+ *
+ *  wsg50_log_convert turns a log into CSV or a rosbag.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section sample_log.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef SAMPLE_LOG_H_
+#define SAMPLE_LOG_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define SAMPLE_LOG_MAGIC "WSG50LOG"
+#define SAMPLE_LOG_VERSION 1
+
+// sample_record.flags
+#define SAMPLE_HAS_CLOCK	0x01	// seq and device_ms are valid
+#define SAMPLE_HAS_STATE	0x02	// state is valid
+#define SAMPLE_TACTILE0		0x04	// tactile0 is valid
+#define SAMPLE_TACTILE1		0x08	// tactile1 is valid
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef struct
+{
+	char magic[8];				// SAMPLE_LOG_MAGIC, not terminated
+	uint32_t version;			// SAMPLE_LOG_VERSION
+	uint32_t record_size;		// sizeof( sample_record )
+	uint64_t capacity;			// Slots in the ring
+	uint64_t count;				// Records appended so far
+	double created;				// Host time the log was opened [s]
+	uint8_t reserved[24];
+} sample_log_header;
+
+
+typedef struct
+{
+	uint64_t index;				// Append number, 1-based; 0 marks an empty or incomplete slot
+	double stamp;				// Estimated sampling instant, host clock [s]
+	double received;			// Monotonic time the sample was handled [s]
+	uint32_t seq;				// Script sequence number
+	uint32_t device_ms;			// Gripper tick [ms]
+	uint32_t state;				// System state bitmask
+	uint32_t flags;				// SAMPLE_* flags
+	float position;				// [mm]
+	float speed;				// [mm/s]
+	float force;				// [N]
+	float force_finger0, force_finger1;	// [N]
+	float tactile0[25], tactile1[25];	// Finger sensor values
+	uint32_t reserved;
+} sample_record;
+
+
+class SampleLog
+{
+public:
+	SampleLog();
+	~SampleLog();
+
+	/**
+	 * Create (or truncate) and map a log file
+	 *
+	 * @param path			File name
+	 * @param capacity		Number of records kept
+	 * @param created		Host time written to the header [s]
+	 *
+	 * @return 0 on success, -1 otherwise (errno is set)
+	 */
+	int open( const char *path, uint64_t capacity, double created );
+
+	/** \brief Flush and unmap, safe to call when not open */
+	void close();
+
+	bool is_open() const { return header_ != NULL; }
+
+	/** \brief Store a record, its index is set here. Single writer. */
+	void append( const sample_record &record );
+
+	/** \brief Records appended since open() */
+	uint64_t count() const;
+
+private:
+	SampleLog( const SampleLog & );
+	SampleLog & operator=( const SampleLog & );
+
+	sample_log_header *header_;
+	sample_record *records_;
+	size_t size_;				// Mapped bytes
+	uint64_t count_;			// Writer's copy of header_->count
+};
+
+
+//------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------
+
+/**
+ * Read the complete records of a log, also while it is being written
+ *
+ * @param path			File name
+ * @param *header		Receives the header
+ * @param records		Receives the records in append order
+ *
+ * @return 0 on success, -1 if the file can't be read or is no sample log
+ */
+int sample_log_read( const char *path, sample_log_header *header, std::vector<sample_record> &records );
+
+
+#endif /* SAMPLE_LOG_H_ */
@@ -0,0 +1,190 @@
+//======================================================================
+/**
+ *  @file
+ *  state_cache.h
+ *
+ *  @section state_cache.h_general General file information
+ *
+ *  @brief
+ *  Latest-state cache shared by all acquisition modes.
+ *
+ *  Every response that carries a measurement (getOpening(), getSpeed(),
+ *  getForce(), script_measure_move() and the auto update stream read by
+ *  the driver) is written into the cache together with a monotonic
+ *  timestamp. Queries like getOpeningCached() answer from the cache
+ *  when the value is younger than the requested age and only fall back
+ *  to a round trip to the gripper otherwise.
+ *
+ *  Readers are lock-free (seqlock), they never block the thread that
+ *  owns the connection. Writers are serialized with a mutex, they are
+ *  rare compared to readers and never wait on I/O while holding it.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section state_cache.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef STATE_CACHE_H_
+#define STATE_CACHE_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef enum
+{
+	CACHE_OPENING = 0,		// Opening width [mm]
+	CACHE_SPEED,			// Finger speed [mm/s]
+	CACHE_FORCE,			// Grasping force [N]
+	CACHE_FIELDS
+} cache_field_t;
+
+
+typedef struct
+{
+	float value[CACHE_FIELDS];
+	double stamp[CACHE_FIELDS];		// Monotonic time of the last update [s], 0 if never updated
+} gripper_state;
+
+
+/**
+ * Sequence lock for a trivially copyable value: any number of lock-free
+ * readers, one writer at a time (serialized by the caller).
+ */
+
+template <class T>
+class Seqlock
+{
+public:
+	Seqlock() : seq_( 0 ), value_() {}
+
+	Seqlock( const Seqlock & ) = delete;
+	Seqlock & operator=( const Seqlock & ) = delete;
+
+	void store( const T &value )
+	{
+		unsigned int seq = seq_.load( std::memory_order_relaxed );
+
+		seq_.store( seq + 1, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_release );
+		value_ = value;
+		seq_.store( seq + 2, std::memory_order_release );
+	}
+
+	T load() const
+	{
+		unsigned int seq0, seq1;
+		T value;
+
+		do
+		{
+			seq0 = seq_.load( std::memory_order_acquire );
+			value = value_;
+			std::atomic_thread_fence( std::memory_order_acquire );
+			seq1 = seq_.load( std::memory_order_relaxed );
+		}
+		while ( ( seq0 & 1 ) || seq0 != seq1 );
+
+		return value;
+	}
+
+private:
+	std::atomic<unsigned int> seq_;
+	T value_;
+};
+
+
+class StateCache
+{
+public:
+	StateCache() {}
+
+	StateCache( const StateCache & ) = delete;
+	StateCache & operator=( const StateCache & ) = delete;
+
+	/** \brief Monotonic time in seconds, used for all stamps of the cache */
+	static double now()
+	{
+		return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+	}
+
+	void update( cache_field_t field, float value, double stamp = now() )
+	{
+		std::lock_guard<std::mutex> lock( write_mutex_ );
+		gripper_state s = state_.load();
+
+		s.value[field] = value;
+		s.stamp[field] = stamp;
+		state_.store( s );
+	}
+
+	/** \brief Update opening, speed and force at once (script responses) */
+	void update( float opening, float speed, float force, double stamp = now() )
+	{
+		std::lock_guard<std::mutex> lock( write_mutex_ );
+		gripper_state s = state_.load();
+
+		s.value[CACHE_OPENING] = opening; s.stamp[CACHE_OPENING] = stamp;
+		s.value[CACHE_SPEED] = speed; s.stamp[CACHE_SPEED] = stamp;
+		s.value[CACHE_FORCE] = force; s.stamp[CACHE_FORCE] = stamp;
+		state_.store( s );
+	}
+
+	gripper_state snapshot() const { return state_.load(); }
+
+	/**
+	 * Read one field if it is not older than max_age
+	 *
+	 * @param field		Field to read
+	 * @param max_age	Maximum age [s]
+	 * @param *value	Set to the cached value if fresh enough
+	 * @param *age		Set to the age of the cached value [s], may be NULL
+	 *
+	 * @return true if the cached value is fresh enough
+	 */
+
+	bool get( cache_field_t field, double max_age, float *value, double *age = 0 ) const
+	{
+		gripper_state s = state_.load();
+		double a;
+
+		if ( s.stamp[field] <= 0.0 ) return false;
+
+		a = now() - s.stamp[field];
+		if ( age ) *age = a;
+		if ( a > max_age ) return false;
+
+		*value = s.value[field];
+		return true;
+	}
+
+private:
+	Seqlock<gripper_state> state_;
+	std::mutex write_mutex_;
+};
+
+
+//------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------
+
+/** \brief Driver-wide state cache, fed by functions.cpp and the driver's acquisition loop */
+StateCache & state_cache();
+
+
+#endif /* STATE_CACHE_H_ */
@@ -0,0 +1,300 @@
+//======================================================================
+/**
+ *  @file
+ *  state_estimator.h
+ *
+ *  @section state_estimator.h_general General file information
+ *
+ *  @brief
+ *  Kalman filter of the finger opening, predicted between samples.
+ *
+ *  State [position, velocity] in mm and mm/s. Between two samples the
+ *  velocity follows the last commanded velocity as a first order lag
+ *  (command_tau), or stays constant without a command; white
+ *  acceleration noise (accel_noise) covers the rest. Every sample is
+ *  fused at its sampling instant: the position, and the speed when the
+ *  device measured it.
+ *
+ *  predict() extrapolates the last fused state to any later instant,
+ *  e.g. "now" when publishing faster than the device delivers samples,
+ *  which also compensates the transport latency. The extrapolation stops
+ *  after max_prediction seconds, so a stalled device doesn't send the
+ *  estimate away, and at the target of a position command.
+ *
+ *  The innovation (sample minus prediction) of the last sample, its RMS
+ *  and its normalized square (NIS, ~1 for a consistent filter) are kept
+ *  to tune the noise parameters.
+ *
+ *  All functions are thread safe: samples come from the I/O loop, the
+ *  predictions from the publishing thread.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section state_estimator.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef STATE_ESTIMATOR_H_
+#define STATE_ESTIMATOR_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+#include <mutex>
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef struct
+{
+	double accel_noise;		// Spectral density of the white acceleration noise [mm^2/s^3]
+	double position_noise;	// Std. deviation of the measured opening [mm]
+	double speed_noise;		// Std. deviation of the measured speed [mm/s]
+	double command_tau;		// Time constant of the velocity following a command [s], <= 0 ignores commands
+	double command_timeout;	// A speed command is dropped after this time [s]
+	double max_prediction;	// Longest extrapolation [s]
+} state_estimator_params;
+
+
+typedef struct
+{
+	double time;			// Instant of the estimate [s]
+	double position;		// [mm]
+	double velocity;		// [mm/s]
+	double covariance[4];	// Row-major [pp pv; vp vv], [mm^2, mm^2/s, mm^2/s^2]
+	double prediction;		// Time extrapolated since the last sample [s]
+	double innovation_position;		// Last sample minus its prediction [mm]
+	double innovation_velocity;		// [mm/s], 0 without measured speed
+	double innovation_rms;	// Position innovation, exponential RMS [mm]
+	double nis;				// Normalized innovation squared of the last position
+	unsigned long samples;	// Samples fused since reset()
+} state_estimate;
+
+
+class StateEstimator
+{
+public:
+	StateEstimator()
+	{
+		params_.accel_noise = 5.0E4;
+		params_.position_noise = 0.05;
+		params_.speed_noise = 2.0;
+		params_.command_tau = 0.05;
+		params_.command_timeout = 0.5;
+		params_.max_prediction = 0.1;
+		reset();
+	}
+
+	void set_params( const state_estimator_params &params )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		params_ = params;
+	}
+
+	state_estimator_params params() const
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		return params_;
+	}
+
+	/** \brief Forget the state, the next sample initializes it */
+	void reset()
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		initialized_ = false;
+		has_command_ = false;
+		x_[0] = x_[1] = 0.0;
+		P_[0] = P_[1] = P_[2] = P_[3] = 0.0;
+		time_ = 0.0;
+		innovation_[0] = innovation_[1] = 0.0;
+		mean_square_ = 0.0;
+		nis_ = 0.0;
+		samples_ = 0;
+	}
+
+	/**
+	 * Commanded velocity, used by the following predictions
+	 *
+	 * @param time		Instant the command was sent [s]
+	 * @param velocity	[mm/s]
+	 * @param target	Opening where the motion ends [mm], NAN for a speed command
+	 */
+	void command( double time, double velocity, double target = NAN )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		has_command_ = true;
+		command_time_ = time;
+		command_velocity_ = velocity;
+		command_target_ = target;
+	}
+
+	/** \brief Position command: speed [mm/s] towards target [mm] from the current estimate */
+	void command_position( double time, double target, double speed )
+	{
+		double position;
+		{
+			std::lock_guard<std::mutex> lock( mutex_ );
+			if ( !initialized_ ) return;
+			position = x_[0];
+		}
+		command( time, target >= position ? fabs( speed ) : -fabs( speed ), target );
+	}
+
+	/**
+	 * Fuse a sample
+	 *
+	 * @param time			Sampling instant [s]
+	 * @param position		[mm]
+	 * @param speed			[mm/s]
+	 * @param has_speed		false if the speed wasn't measured
+	 *
+	 * @return false if the sample is older than the last one and was dropped
+	 */
+	bool update( double time, double position, double speed, bool has_speed )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		double r_p = params_.position_noise * params_.position_noise;
+		double r_v = params_.speed_noise * params_.speed_noise;
+
+		if ( !initialized_ )
+		{
+			initialized_ = true;
+			time_ = time;
+			x_[0] = position;
+			x_[1] = has_speed ? speed : 0.0;
+			P_[0] = r_p;
+			P_[1] = P_[2] = 0.0;
+			P_[3] = has_speed ? r_v : 1.0E4;
+			samples_ = 1;
+			return true;
+		}
+		if ( time < time_ ) return false;
+
+		propagate( time - time_, x_, P_ );
+		time_ = time;
+
+		// Position, then speed: independent noise, two scalar updates
+		double y = position - x_[0];
+		double s = P_[0] + r_p;
+		innovation_[0] = y;
+		nis_ = y * y / s;
+		mean_square_ = samples_ == 1 ? y * y : 0.95 * mean_square_ + 0.05 * y * y;
+		correct( y, s, 0 );
+
+		innovation_[1] = 0.0;
+		if ( has_speed )
+		{
+			y = speed - x_[1];
+			innovation_[1] = y;
+			correct( y, P_[3] + r_v, 1 );
+		}
+		samples_++;
+		return true;
+	}
+
+	/**
+	 * Estimate at an instant after the last sample
+	 *
+	 * @return false before the first sample
+	 */
+	bool predict( double time, state_estimate *estimate ) const
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		if ( !initialized_ ) return false;
+
+		double dt = time - time_;
+		if ( dt < 0.0 ) dt = 0.0;
+		if ( dt > params_.max_prediction ) dt = params_.max_prediction;
+
+		double x[2] = { x_[0], x_[1] };
+		double P[4] = { P_[0], P_[1], P_[2], P_[3] };
+		propagate( dt, x, P );
+
+		estimate->time = time;
+		estimate->position = x[0];
+		estimate->velocity = x[1];
+		for ( int i = 0; i < 4; i++ ) estimate->covariance[i] = P[i];
+		estimate->prediction = dt;
+		estimate->innovation_position = innovation_[0];
+		estimate->innovation_velocity = innovation_[1];
+		estimate->innovation_rms = sqrt( mean_square_ );
+		estimate->nis = nis_;
+		estimate->samples = samples_;
+		return true;
+	}
+
+private:
+	/** \brief x, P from time_ to time_ + dt (mutex held) */
+	void propagate( double dt, double *x, double *P ) const
+	{
+		if ( dt <= 0.0 ) return;
+
+		// Transition [1 b; 0 a] and input term [c; 1 - a] of the commanded velocity
+		double a = 1.0, b = dt, c = 0.0, u = 0.0;
+		bool commanded = has_command_ && params_.command_tau > 0.0 &&
+						 ( !isnan( command_target_ ) || time_ - command_time_ <= params_.command_timeout );
+		if ( commanded )
+		{
+			a = exp( -dt / params_.command_tau );
+			b = params_.command_tau * ( 1.0 - a );
+			c = dt - b;
+			u = command_velocity_;
+		}
+
+		double p = x[0] + b * x[1] + c * u;
+		double v = a * x[1] + ( 1.0 - a ) * u;
+
+		// No motion past the target of a position command
+		if ( commanded && !isnan( command_target_ ) &&
+			 ( ( u > 0.0 && p > command_target_ ) || ( u < 0.0 && p < command_target_ ) ) )
+		{
+			p = u > 0.0 ? fmax( x[0], command_target_ ) : fmin( x[0], command_target_ );
+			v = 0.0;
+		}
+		x[0] = p;
+		x[1] = v;
+
+		// P = F P F' + Q, Q of white acceleration noise
+		double q = params_.accel_noise;
+		double p00 = P[0] + b * ( P[1] + P[2] ) + b * b * P[3] + q * dt * dt * dt / 3.0;
+		double p01 = a * ( P[1] + b * P[3] ) + q * dt * dt / 2.0;
+		double p11 = a * a * P[3] + q * dt;
+		P[0] = p00;
+		P[1] = P[2] = p01;
+		P[3] = p11;
+	}
+
+	/** \brief Scalar update of state i with innovation y and its variance s */
+	void correct( double y, double s, int i )
+	{
+		double k0 = P_[i] / s, k1 = P_[2 + i] / s;
+		double pi0 = P_[i * 2], pi1 = P_[i * 2 + 1];
+		x_[0] += k0 * y;
+		x_[1] += k1 * y;
+		P_[0] -= k0 * pi0;
+		P_[1] -= k0 * pi1;
+		P_[2] = P_[1];
+		P_[3] -= k1 * pi1;
+	}
+
+	mutable std::mutex mutex_;
+	state_estimator_params params_;
+	bool initialized_;
+	double x_[2], P_[4], time_;
+	bool has_command_;
+	double command_time_, command_velocity_, command_target_;
+	double innovation_[2], mean_square_, nis_;
+	unsigned long samples_;
+};
+
+
+#endif /* STATE_ESTIMATOR_H_ */
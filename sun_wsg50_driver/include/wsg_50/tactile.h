@@ -0,0 +1,65 @@
+//======================================================================
+/**
+ *  @file
+ *  tactile.h
+ *
+ *  @section tactile.h_general General file information
+ *
+ *  @brief
+ *  Decoding of the finger sensor data of the measure scripts.
+ *
+ *  A generic finger with the tactile sensor sends 25 taxels as
+ *  little endian uint16 ADC counts (50 bytes). They are converted to
+ *  volts, count * 3.3 V / 4096, with SSE2 or NEON where available,
+ *  8 taxels per iteration. tactile_decode_scalar() is the plain loop,
+ *  used on other hosts and as reference.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section tactile.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef TACTILE_H_
+#define TACTILE_H_
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define TACTILE_TAXELS		25				// Taxels per finger
+#define TACTILE_ROWS		5
+#define TACTILE_COLS		5
+#define TACTILE_BYTES		( 2 * TACTILE_TAXELS )
+#define TACTILE_VREF		3.3f			// ADC reference [V]
+#define TACTILE_ADC_RANGE	4096.0f			// 12 bit ADC
+
+// Finger block heads in the measure script responses
+#define FINGER_NONE			0				// No data follows
+#define FINGER_GENERIC		1				// TACTILE_BYTES sensor data follow
+#define FINGER_FMF			2				// float force [N] follows
+
+
+//------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------
+
+/**
+ * Convert little endian uint16 ADC counts to volts
+ *
+ * @param *raw		2 * count bytes
+ * @param *volts	Receives count values [V]
+ * @param count		Number of taxels
+ */
+void tactile_decode( const unsigned char *raw, float *volts, int count );
+
+/** \brief Same as tactile_decode(), one taxel at a time */
+void tactile_decode_scalar( const unsigned char *raw, float *volts, int count );
+
+
+#endif /* TACTILE_H_ */
@@ -0,0 +1,131 @@
+//======================================================================
+/**
+ *  @file
+ *  tactile_calibration.h
+ *
+ *  @section tactile_calibration.h_general General file information
+ *
+ *  @brief
+ *  Per-taxel calibration of the finger sensor voltages to pressures,
+ *  total normal force and center of pressure.
+ *
+ *  Every taxel has either a linear model, pressure = gain * (V - offset),
+ *  or a table of (V, pressure) points. Tables are resampled at load time
+ *  on TACTILE_LUT_POINTS uniform steps over 0..TACTILE_VREF, so applying
+ *  one is an index and a linear interpolation. apply() is a single
+ *  SSE2/NEON pass, 4 taxels at a time: linear models, table lookups
+ *  (only in blocks with table taxels), threshold, force and moment sums.
+ *
+ *  Calibration file, one statement per line, '#' starts a comment:
+ *
+ *    pitch <row mm> <col mm>		Taxel spacing (default 3.4 3.4)
+ *    area <mm^2>					Taxel area (default 11.56)
+ *    threshold <kPa>				Lower pressures are 0 (default 0)
+ *    <finger> <taxel> linear <offset V> <gain kPa/V>
+ *    <finger> <taxel> table <V> <kPa> [<V> <kPa> ...]
+ *
+ *  finger is 0 or 1, taxel 0..24 row-major or '*' for all taxels of the
+ *  finger; later lines override earlier ones. Table volts must increase,
+ *  the first and last pressures hold outside the table. A finger is
+ *  calibrated completely or not at all (its pressures are then 0), and
+ *  at least one finger must be: files with another statement, a short
+ *  or extra value, or a partially calibrated finger are rejected.
+ *
+ *  The center of pressure is in the sensor frame [mm]: origin at the
+ *  center taxel, x along the columns, y along the rows.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section tactile_calibration.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef TACTILE_CALIBRATION_H_
+#define TACTILE_CALIBRATION_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <string>
+
+#include "wsg_50/tactile.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define TACTILE_LUT_POINTS	64				// Resampled table points per taxel
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef struct
+{
+	float pressure[TACTILE_TAXELS];		// Row-major [kPa]
+	float force;						// Total normal force [N]
+	float cop_x, cop_y;					// Center of pressure [mm], NAN without load
+} tactile_map;
+
+
+class TactileCalibration
+{
+public:
+	TactileCalibration();
+
+	/**
+	 * Load a calibration file, see above. The current calibration is
+	 * kept if the file has an error.
+	 *
+	 * @param path		File name
+	 * @param *error	Receives the reason of a failure, may be NULL
+	 *
+	 * @return 0 on success, -1 otherwise
+	 */
+	int load( const char *path, std::string *error );
+
+	/** \brief A calibration was loaded */
+	bool loaded() const { return loaded_; }
+
+	/**
+	 * Calibrate the voltages of one finger
+	 *
+	 * @param finger	0 or 1
+	 * @param *volts	TACTILE_TAXELS voltages, see tactile_decode()
+	 * @param *map		Receives pressures, force and center of pressure
+	 */
+	void apply( int finger, const float *volts, tactile_map *map ) const;
+
+	/** \brief Same as apply(), one taxel at a time */
+	void apply_scalar( int finger, const float *volts, tactile_map *map ) const;
+
+private:
+	struct finger_table
+	{
+		float offset[TACTILE_TAXELS];	// Linear models
+		float gain[TACTILE_TAXELS];
+		unsigned int table[TACTILE_TAXELS];	// ~0 for a table taxel, as SIMD lane mask
+		float lut[TACTILE_TAXELS][TACTILE_LUT_POINTS];
+	};
+
+	void set_geometry( float pitch_row, float pitch_col );
+	float lookup( int finger, int taxel, float volts ) const;
+	void finish( tactile_map *map, float sum, float sum_x, float sum_y ) const;
+
+	finger_table fingers_[2];
+	float x_[TACTILE_TAXELS], y_[TACTILE_TAXELS];	// Taxel centers [mm]
+	float area_;						// [mm^2]
+	float threshold_;					// [kPa]
+	bool loaded_;
+};
+
+
+#endif /* TACTILE_CALIBRATION_H_ */
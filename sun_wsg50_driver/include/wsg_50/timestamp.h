@@ -0,0 +1,186 @@
+//======================================================================
+/**
+ *  @file
+ *  timestamp.h
+ *
+ *  @section timestamp.h_general General file information
+ *
+ *  @brief
+ *  Estimation of the instant a measurement was sampled on the gripper.
+ *
+ *  A measurement answered by the gripper was taken somewhere between
+ *  sending the request and receiving the response. For every exchange
+ *  the send and receive times (see msg_get_times()) are recorded and
+ *  the sampling instant is estimated as
+ *    STAMP_RECEIVE   receive time (no compensation)
+ *    STAMP_MIDPOINT  send time + RTT / 2
+ *    STAMP_LEARNED   receive time - learned return delay, the return
+ *                    delay being half of the minimum RTT of the window.
+ *                    Queueing on the host only adds to the RTT, the
+ *                    minimum is the best estimate of the pure latency.
+ *  Frames pushed by the gripper (auto update) have no send time, they
+ *  are stamped with receive time - learned return delay, except in
+ *  STAMP_RECEIVE mode.
+ *
+ *  The RTTs of the last TIMESTAMP_WINDOW exchanges are kept for the
+ *  statistics (min, percentiles, max, mean).
+ *
+ *  All times are monotonic seconds (Gripper::now()).
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section timestamp.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef TIMESTAMP_H_
+#define TIMESTAMP_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define TIMESTAMP_WINDOW		512		// Number of RTTs kept for minimum and statistics
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef enum
+{
+	STAMP_RECEIVE = 0,
+	STAMP_MIDPOINT,
+	STAMP_LEARNED
+} stamp_mode_t;
+
+
+typedef struct
+{
+	unsigned long count;		// Exchanges since start
+	unsigned int window;		// Exchanges in the statistics below
+	double min, p50, p90, p99, max, mean;		// RTT [s]
+	double return_delay;		// Learned return delay [s]
+} rtt_stats;
+
+
+class TimestampModel
+{
+public:
+	TimestampModel() : mode_( STAMP_MIDPOINT ), rtt_( TIMESTAMP_WINDOW, 0.0 ), next_( 0 ), count_( 0 ) {}
+
+	TimestampModel( const TimestampModel & ) = delete;
+	TimestampModel & operator=( const TimestampModel & ) = delete;
+
+	void set_mode( stamp_mode_t mode ) { mode_ = mode; }
+	stamp_mode_t mode() const { return mode_; }
+
+	/**
+	 * Record a request/response exchange
+	 *
+	 * @param sent		Time the request was sent [s]
+	 * @param received	Time the response was received [s]
+	 *
+	 * @return Estimated sampling instant [s]
+	 */
+
+	double exchange( double sent, double received )
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		double rtt = received - sent;
+
+		if ( sent <= 0.0 || rtt < 0.0 ) return received;
+
+		rtt_[next_] = rtt;
+		next_ = ( next_ + 1 ) % TIMESTAMP_WINDOW;
+		count_++;
+
+		switch ( mode_ )
+		{
+		case STAMP_MIDPOINT: return sent + rtt / 2.0;
+		case STAMP_LEARNED: return received - return_delay();
+		default: return received;
+		}
+	}
+
+	/**
+	 * Estimate the sampling instant of a frame pushed by the gripper
+	 *
+	 * @param received	Time the frame was received [s]
+	 */
+
+	double pushed( double received ) const
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+
+		if ( mode_ == STAMP_RECEIVE ) return received;
+		return received - return_delay();
+	}
+
+	rtt_stats stats() const
+	{
+		std::lock_guard<std::mutex> lock( mutex_ );
+		rtt_stats s;
+		std::vector<double> v;
+
+		memset( &s, 0, sizeof( s ) );
+		s.count = count_;
+		s.window = (unsigned int) std::min<unsigned long>( count_, TIMESTAMP_WINDOW );
+		if ( s.window == 0 ) return s;
+
+		v.assign( rtt_.begin(), rtt_.begin() + s.window );
+		std::sort( v.begin(), v.end() );
+		s.min = v.front();
+		s.max = v.back();
+		s.p50 = v[( v.size() - 1 ) * 50 / 100];
+		s.p90 = v[( v.size() - 1 ) * 90 / 100];
+		s.p99 = v[( v.size() - 1 ) * 99 / 100];
+		for ( size_t i = 0; i < v.size(); i++ ) s.mean += v[i];
+		s.mean /= (double) v.size();
+		s.return_delay = s.min / 2.0;
+
+		return s;
+	}
+
+private:
+	/** \brief Half of the minimum RTT in the window, 0 without exchanges */
+	double return_delay() const
+	{
+		size_t n = (size_t) std::min<unsigned long>( count_, TIMESTAMP_WINDOW );
+
+		if ( n == 0 ) return 0.0;
+		return *std::min_element( rtt_.begin(), rtt_.begin() + n ) / 2.0;
+	}
+
+	mutable std::mutex mutex_;
+	stamp_mode_t mode_;
+	std::vector<double> rtt_;
+	unsigned int next_;
+	unsigned long count_;
+};
+
+
+//------------------------------------------------------------------------
+// Function declaration
+//------------------------------------------------------------------------
+
+/** \brief Driver-wide timestamp model, fed by functions.cpp and the driver's acquisition loop */
+TimestampModel & timestamp_model();
+
+
+#endif /* TIMESTAMP_H_ */
@@ -0,0 +1,75 @@
+//======================================================================
+/**
+ *  @file
+ *  trace.h
+ *
+ *  @section trace.h_general General file information
+ *
+ *  @brief
+ *  Static tracepoints (USDT) in the command and frame path.
+ *
+ *  With WSG50_ENABLE_USDT defined (CMake option WSG50_ENABLE_TRACING),
+ *  the probes are emitted with <sys/sdt.h> under the provider "wsg50"
+ *  and can be attached with bpftrace/perf/bcc, e.g.
+ *  scripts/wsg50_latency.bt. A probe that is not attached
+ *  costs a single nop. Without the define all macros expand to nothing.
+ *
+ *  Probes:
+ *    frame_send(id, len)           before a frame is written
+ *    frame_sent(id, len)           frame completely written
+ *    frame_rx_header(id, len)      header received (first bytes of a frame)
+ *    frame_resync(byte)            one byte dropped while syncing to the preamble
+ *    frame_complete(id, len)       frame received with valid checksum
+ *    frame_crc_fail(id, len)       frame received with checksum error
+ *    cmd_start(id, len)            cmd_submit() entered
+ *    cmd_pending(id)               CMD_PENDING received, waiting again
+ *    cmd_complete(id, status, len) cmd_submit() returns
+ *    publish_start(loop)           ROS publishing starts (0 timer_cb, 1 read_thread)
+ *    publish_done(loop)            ROS publishing finished
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section trace.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#ifdef WSG50_ENABLE_USDT
+#include <sys/sdt.h>
+#endif
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define TRACE_LOOP_TIMER		0
+#define TRACE_LOOP_READ_THREAD	1
+
+#ifdef WSG50_ENABLE_USDT
+
+#define WSG50_TRACE1( name, a )			DTRACE_PROBE1( wsg50, name, a )
+#define WSG50_TRACE2( name, a, b )		DTRACE_PROBE2( wsg50, name, a, b )
+#define WSG50_TRACE3( name, a, b, c )	DTRACE_PROBE3( wsg50, name, a, b, c )
+
+#else
+
+#define WSG50_TRACE1( name, a )			do {} while ( 0 )
+#define WSG50_TRACE2( name, a, b )		do {} while ( 0 )
+#define WSG50_TRACE3( name, a, b, c )	do {} while ( 0 )
+
+#endif
+
+
+#endif /* TRACE_H_ */
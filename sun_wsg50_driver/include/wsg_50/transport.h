@@ -0,0 +1,444 @@
+//======================================================================
+/**
+ *  @file
+ *  transport.h
+ *
+ *  @section transport.h_general General file information
+ *
+ *  @brief
+ *  Header-only transport policies for the templated Gripper class.
+ *
+ *  Every transport provides open(), close(), read() and write() as
+ *  inline members, so that the framing code in gripper.h can be
+ *  compiled into a single path without going through the function
+ *  pointers of interface_t.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section transport.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef TRANSPORT_H_
+#define TRANSPORT_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <vector>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "common.h"
+#include "interface.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define TRANSPORT_TCP_RCV_TIMEOUT_SEC		60
+#define TRANSPORT_UDP_RCV_TIMEOUT_SEC		10
+#define TRANSPORT_UDP_RCV_BUFSIZE			1024
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+/**
+ * TCP transport. Owns its socket, so several grippers can be
+ * connected from the same process.
+ */
+
+class TcpTransport
+{
+public:
+	TcpTransport() : sock_( -1 ) {}
+	~TcpTransport() { close(); }
+
+	TcpTransport( const TcpTransport & ) = delete;
+	TcpTransport & operator=( const TcpTransport & ) = delete;
+
+	int open( const char *addr, unsigned short port )
+	{
+		struct sockaddr_in si_server;
+		unsigned int val = 1024;
+		int nodelay = 1;
+		struct timeval timeout = { TRANSPORT_TCP_RCV_TIMEOUT_SEC, 0 };
+
+		if ( !addr || sock_ >= 0 ) return -1;
+
+		sock_ = socket( PF_INET, SOCK_STREAM, IPPROTO_TCP );
+		if ( sock_ < 0 )
+		{
+			fprintf( stderr, "Cannot open TCP socket\n" );
+			return -1;
+		}
+
+		memset( &si_server, 0, sizeof( si_server ) );
+		si_server.sin_family = AF_INET;
+		si_server.sin_port = htons( port );
+		si_server.sin_addr.s_addr = str_to_ipaddr( addr );
+
+		setsockopt( sock_, SOL_SOCKET, SO_RCVBUF, (void *) &val, (socklen_t) sizeof( val ) );
+		setsockopt( sock_, SOL_SOCKET, SO_RCVTIMEO, (void *) &timeout, (socklen_t) sizeof( timeout ) );
+
+		// Frames are written in one piece, don't let Nagle hold them back
+		setsockopt( sock_, IPPROTO_TCP, TCP_NODELAY, (void *) &nodelay, (socklen_t) sizeof( nodelay ) );
+
+		if ( connect( sock_, (struct sockaddr *) &si_server, sizeof( si_server ) ) < 0 )
+		{
+			close();
+			return -1;
+		}
+
+		return 0;
+	}
+
+	void close()
+	{
+		if ( sock_ >= 0 ) ::close( sock_ );
+		sock_ = -1;
+	}
+
+	int read( unsigned char *buf, unsigned int len )
+	{
+		if ( sock_ < 0 ) return -1;
+		return (int) recv( sock_, buf, len, 0 );
+	}
+
+	int write( const unsigned char *buf, unsigned int len )
+	{
+		if ( sock_ < 0 ) return -1;
+		return (int) send( sock_, buf, len, MSG_NOSIGNAL );
+	}
+
+private:
+	int sock_;
+};
+
+
+/**
+ * UDP transport. Datagrams are buffered, read() hands out
+ * the buffered bytes until the datagram is consumed.
+ */
+
+class UdpTransport
+{
+public:
+	UdpTransport() : sock_( -1 ), server_( 0 ), rcv_bufptr_( 0 ), rcv_bufsize_( 0 ) {}
+	~UdpTransport() { close(); }
+
+	UdpTransport( const UdpTransport & ) = delete;
+	UdpTransport & operator=( const UdpTransport & ) = delete;
+
+	int open( unsigned short local_port, const char *addr, unsigned short remote_port )
+	{
+		struct sockaddr_in si_listen;
+		unsigned int val = TRANSPORT_UDP_RCV_BUFSIZE;
+		struct timeval timeout = { TRANSPORT_UDP_RCV_TIMEOUT_SEC, 0 };
+
+		if ( !addr || sock_ >= 0 ) return -1;
+
+		server_ = str_to_ipaddr( addr );
+		rcv_bufptr_ = 0;
+		rcv_bufsize_ = 0;
+
+		sock_ = socket( PF_INET, SOCK_DGRAM, IPPROTO_UDP );
+		if ( sock_ < 0 )
+		{
+			fprintf( stderr, "Cannot open UDP socket\n" );
+			return -1;
+		}
+
+		memset( &si_server_, 0, sizeof( si_server_ ) );
+		si_server_.sin_family = AF_INET;
+		si_server_.sin_port = htons( remote_port );
+		si_server_.sin_addr.s_addr = server_;
+
+		memset( &si_listen, 0, sizeof( si_listen ) );
+		si_listen.sin_family = AF_INET;
+		si_listen.sin_addr.s_addr = htonl( INADDR_ANY );
+		si_listen.sin_port = htons( local_port );
+
+		setsockopt( sock_, SOL_SOCKET, SO_RCVBUF, (void *) &val, (socklen_t) sizeof( val ) );
+		setsockopt( sock_, SOL_SOCKET, SO_RCVTIMEO, (void *) &timeout, (socklen_t) sizeof( timeout ) );
+
+		if ( bind( sock_, (struct sockaddr *) &si_listen, sizeof( si_listen ) ) < 0 )
+		{
+			fprintf( stderr, "Cannot bind port %d\n", local_port );
+			close();
+			return -1;
+		}
+
+		return 0;
+	}
+
+	void close()
+	{
+		if ( sock_ >= 0 ) ::close( sock_ );
+		sock_ = -1;
+	}
+
+	int read( unsigned char *buf, unsigned int len )
+	{
+		unsigned int n;
+
+		if ( sock_ < 0 ) return -1;
+		if ( len == 0 ) return 0;
+
+		if ( rcv_bufptr_ >= rcv_bufsize_ )
+		{
+			struct sockaddr_in si_incoming;
+			socklen_t slen = sizeof( si_incoming );
+			int incoming;
+
+			incoming = (int) recvfrom( sock_, rcv_buf_, TRANSPORT_UDP_RCV_BUFSIZE, 0,
+									   (struct sockaddr *) &si_incoming, &slen );
+			if ( incoming < 0 ) return -1;
+			if ( si_incoming.sin_addr.s_addr != server_ )
+			{
+				fprintf( stderr, "Message from unknown server!\n" );
+				return -1;
+			}
+
+			rcv_bufptr_ = 0;
+			rcv_bufsize_ = (unsigned int) incoming;
+		}
+
+		n = rcv_bufsize_ - rcv_bufptr_;
+		if ( len < n ) n = len;
+		memcpy( buf, &rcv_buf_[rcv_bufptr_], n );
+		rcv_bufptr_ += n;
+
+		return (int) n;
+	}
+
+	int write( const unsigned char *buf, unsigned int len )
+	{
+		if ( sock_ < 0 ) return -1;
+		return (int) sendto( sock_, buf, len, 0, (struct sockaddr *) &si_server_, sizeof( si_server_ ) );
+	}
+
+private:
+	int sock_;
+	ip_addr_t server_;
+	struct sockaddr_in si_server_;
+	unsigned char rcv_buf_[TRANSPORT_UDP_RCV_BUFSIZE];
+	unsigned int rcv_bufptr_;
+	unsigned int rcv_bufsize_;
+};
+
+
+/**
+ * Serial transport, same line settings as serial.c
+ */
+
+class SerialTransport
+{
+public:
+	SerialTransport() : fd_( -1 ) {}
+	~SerialTransport() { close(); }
+
+	SerialTransport( const SerialTransport & ) = delete;
+	SerialTransport & operator=( const SerialTransport & ) = delete;
+
+	int open( const char *device, unsigned int bitrate )
+	{
+		struct termios settings;
+		speed_t flag;
+
+		if ( !device || fd_ >= 0 ) return -1;
+
+		switch ( bitrate )
+		{
+			case   1200: flag =   B1200; break;
+			case   2400: flag =   B2400; break;
+			case   4800: flag =   B4800; break;
+			case   9600: flag =   B9600; break;
+			case  19200: flag =  B19200; break;
+			case  38400: flag =  B38400; break;
+			case  57600: flag =  B57600; break;
+			case 115200: flag = B115200; break;
+			case 230400: flag = B230400; break;
+			case 460800: flag = B460800; break;
+			default:
+				fprintf( stderr, "Invalid bitrate '%d' for serial device\n", bitrate );
+				return -1;
+		}
+
+		fd_ = ::open( device, O_RDWR | O_NOCTTY );
+		if ( fd_ < 0 )
+		{
+			fprintf( stderr, "Failed to open serial device '%s' (errno: %s)\n", device, strerror( errno ) );
+			return -1;
+		}
+
+		if ( !isatty( fd_ ) )
+		{
+			fprintf( stderr, "Device '%s' is not a terminal device!\n", device );
+			close();
+			return -1;
+		}
+
+		memset( &settings, 0, sizeof( settings ) );
+		settings.c_iflag = IGNBRK | IGNPAR;
+		settings.c_oflag = 0;
+		settings.c_cflag = flag | CS8 | CSTOPB | CREAD | CLOCAL;
+		settings.c_lflag = 0;
+		settings.c_cc[VTIME] = 10;
+		settings.c_cc[VMIN] = 0;
+
+		tcflush( fd_, TCIFLUSH );
+		tcsetattr( fd_, TCSANOW, &settings );
+
+		return 0;
+	}
+
+	void close()
+	{
+		if ( fd_ >= 0 ) ::close( fd_ );
+		fd_ = -1;
+	}
+
+	int read( unsigned char *buf, unsigned int len )
+	{
+		if ( fd_ < 0 ) return -1;
+		return (int) ::read( fd_, buf, len );
+	}
+
+	int write( const unsigned char *buf, unsigned int len )
+	{
+		if ( fd_ < 0 ) return -1;
+		return (int) ::write( fd_, buf, len );
+	}
+
+private:
+	int fd_;
+};
+
+
+/**
+ * In-memory transport. Bytes passed to feed() are handed out by read(),
+ * everything written is collected. With loop enabled, the receive
+ * buffer is replayed once it has been consumed, which allows running
+ * the framing code against a recorded byte stream.
+ */
+
+class SimTransport
+{
+public:
+	SimTransport() : rx_pos_( 0 ), loop_( false ) {}
+
+	void feed( const unsigned char *data, unsigned int len )
+	{
+		rx_.insert( rx_.end(), data, data + len );
+	}
+
+	void set_loop( bool loop ) { loop_ = loop; }
+
+	void clear()
+	{
+		rx_.clear();
+		tx_.clear();
+		rx_pos_ = 0;
+	}
+
+	const std::vector<unsigned char> & written() const { return tx_; }
+	void clear_written() { tx_.clear(); }
+
+	void close() {}
+
+	int read( unsigned char *buf, unsigned int len )
+	{
+		size_t n;
+
+		if ( rx_pos_ >= rx_.size() )
+		{
+			if ( !loop_ || rx_.empty() ) return 0;
+			rx_pos_ = 0;
+		}
+
+		n = rx_.size() - rx_pos_;
+		if ( len < n ) n = len;
+		memcpy( buf, &rx_[rx_pos_], n );
+		rx_pos_ += n;
+
+		return (int) n;
+	}
+
+	int write( const unsigned char *buf, unsigned int len )
+	{
+		tx_.insert( tx_.end(), buf, buf + len );
+		return (int) len;
+	}
+
+private:
+	std::vector<unsigned char> rx_;
+	std::vector<unsigned char> tx_;
+	size_t rx_pos_;
+	bool loop_;
+};
+
+
+/**
+ * Adapter for the interface_t structs of the C API (tcp.c, udp.c,
+ * serial.c). Keeps the function pointer call, used by msg.cpp.
+ */
+
+class InterfaceTransport
+{
+public:
+	InterfaceTransport() : iface_( NULL ) {}
+
+	void set( const interface_t *iface ) { iface_ = iface; }
+	const interface_t * get() const { return iface_; }
+
+	int open( const void *params )
+	{
+		if ( !iface_ || !iface_->open ) return -1;
+		return iface_->open( params );
+	}
+
+	void close()
+	{
+		if ( iface_ && iface_->close ) iface_->close();
+	}
+
+	int read( unsigned char *buf, unsigned int len )
+	{
+		if ( !iface_ || !iface_->read ) return -1;
+		return iface_->read( buf, len );
+	}
+
+	int write( const unsigned char *buf, unsigned int len )
+	{
+		if ( !iface_ || !iface_->write ) return -1;
+		return iface_->write( (unsigned char *) buf, len );
+	}
+
+private:
+	const interface_t *iface_;
+};
+
+
+#endif /* TRANSPORT_H_ */
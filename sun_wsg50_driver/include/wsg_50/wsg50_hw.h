@@ -0,0 +1,130 @@
+//======================================================================
+/**
+ *  @file
+ *  wsg50_hw.h
+ *
+ *  @section wsg50_hw.h_general General file information
+ *
+ *  @brief
+ *  ros_control hardware interface for the WSG50.
+ *
+ *  The finger joint (opening [m], speed [m/s], motor force [N]) is
+ *  exported through the joint state, position, velocity and effort
+ *  joint interfaces. read() and write() never touch the gripper: an I/O
+ *  thread runs the script protocol (0xB2 speed command and measure,
+ *  see lua_script/cmd_vel_out.lua) as fast as the link allows, reads
+ *  the state into the state cache and takes the latest command from a
+ *  mailbox. So the hardware interface can run in the controller
+ *  manager loop of the arm (standalone in wsg50_hw_node or as a
+ *  combined_robot_hw plugin).
+ *
+ *  The scripts only accept speed commands, position and effort
+ *  commands are closed in the I/O thread:
+ *    position:  speed = position_gain * (target - opening)
+ *    effort:    speed = -force_gain * (|target| - |force|) / stiffness
+ *  both clamped to max_speed.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section wsg50_hw.h_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#ifndef WSG50_HW_H_
+#define WSG50_HW_H_
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <atomic>
+#include <list>
+#include <string>
+#include <thread>
+
+#include <ros/ros.h>
+#include <hardware_interface/robot_hw.h>
+#include <hardware_interface/joint_state_interface.h>
+#include <hardware_interface/joint_command_interface.h>
+
+#include "wsg_50/mailbox.h"
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef enum
+{
+	HW_MODE_NONE = 0,		// No controller running, fingers held
+	HW_MODE_POSITION,
+	HW_MODE_VELOCITY,
+	HW_MODE_EFFORT
+} hw_mode_t;
+
+
+typedef struct
+{
+	hw_mode_t mode;
+	double value;			// [m], [m/s] or [N] depending on mode
+} hw_command;
+
+
+class WSG50HW : public hardware_interface::RobotHW
+{
+public:
+	WSG50HW();
+	virtual ~WSG50HW();
+
+	/**
+	 * Connect to the gripper, register the joint and start the I/O thread
+	 *
+	 * @param root_nh		Node handle of the controller manager
+	 * @param robot_hw_nh	Node handle holding the parameters (ip, port, ...)
+	 *
+	 * @return false if the gripper can't be reached
+	 */
+
+	bool init( ros::NodeHandle &root_nh, ros::NodeHandle &robot_hw_nh ) override;
+
+	void read( const ros::Time &time, const ros::Duration &period ) override;
+	void write( const ros::Time &time, const ros::Duration &period ) override;
+
+	bool prepareSwitch( const std::list<hardware_interface::ControllerInfo> &start_list,
+						const std::list<hardware_interface::ControllerInfo> &stop_list ) override;
+	void doSwitch( const std::list<hardware_interface::ControllerInfo> &start_list,
+				   const std::list<hardware_interface::ControllerInfo> &stop_list ) override;
+
+private:
+	void ioLoop();
+	float speedCommand( const hw_command &cmd );
+
+	hardware_interface::JointStateInterface state_interface_;
+	hardware_interface::PositionJointInterface position_interface_;
+	hardware_interface::VelocityJointInterface velocity_interface_;
+	hardware_interface::EffortJointInterface effort_interface_;
+
+	std::string joint_name_;
+	double position_, velocity_, effort_;
+	double position_cmd_, velocity_cmd_, effort_cmd_;
+	hw_mode_t mode_;
+
+	Mailbox<hw_command> command_box_;
+	std::thread io_thread_;
+	std::atomic<bool> running_;
+	bool connected_;
+
+	double max_speed_;			// [mm/s]
+	double position_gain_;		// [1/s]
+	double force_gain_;			// [1/s]
+	double stiffness_;			// [N/m]
+	bool read_force_;
+};
+
+
+#endif /* WSG50_HW_H_ */
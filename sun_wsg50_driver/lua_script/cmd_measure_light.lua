@@ -23,6 +23,16 @@ is_speed = false;
 B_SUCCESS = etob(E_SUCCESS);
 --------------------------------------
 
+---Sequence and device clock------------
+-- Appended to every response as two uint32 (little endian):
+-- sequence number and device tick [ms] at sampling time
+seq = 0;
+function utob(n)
+    n = n % 4294967296;
+    return {n % 256, math.floor(n / 256) % 256, math.floor(n / 65536) % 256, math.floor(n / 16777216) % 256};
+end
+----------------------------------------
+
 ---Fingers Init---------------------
 N_SENSOR_BYTES = 50;
 UART_BIT_R = 115200;
@@ -83,10 +93,20 @@ function process()
   --     mc.stop(); is_speed = false;
   --  end   
     
+    tick = systimer();
+    pos = mc.position();
+    speed = mc.speed();
+    force = mc.aforce();
     finger.write( FINGER_POSITION, "a");
     finger_send = finger.read(FINGER_POSITION,N_SENSOR_BYTES);
-        
-    cmd.send(id, B_SUCCESS, finger_send);
+    seq = seq + 1;
+
+    -- One block per finger: head (0 none, 1 sensor data, 2 FMF force) and data
+    if FINGER_POSITION == 0 then
+        cmd.send(id, B_SUCCESS, ntob(pos), ntob(speed), ntob(force), {1}, finger_send, {0}, utob(seq), utob(tick));
+    else
+        cmd.send(id, B_SUCCESS, ntob(pos), ntob(speed), ntob(force), {0}, {1}, finger_send, utob(seq), utob(tick));
+    end
        
 end
 
@@ -18,6 +18,16 @@ is_speed = false;
 B_SUCCESS = etob(E_SUCCESS);
 --------------------------------------
 
+---Sequence and device clock------------
+-- Appended to every response as two uint32 (little endian):
+-- sequence number and device tick [ms] at sampling time
+seq = 0;
+function utob(n)
+    n = n % 4294967296;
+    return {n % 256, math.floor(n / 256) % 256, math.floor(n / 65536) % 256, math.floor(n / 16777216) % 256};
+end
+----------------------------------------
+
 ---Fingers Init---------------------
 N_SENSOR_BYTES = 50;
 UART_BIT_R = 115200;
@@ -76,12 +86,17 @@ function process()
   --     mc.stop(); is_speed = false;
   --  end   
     
+    tick = systimer();
     finger.write( 0, "a");
     finger0_send = finger.read(0,N_SENSOR_BYTES);
     
+    pos = mc.position();
     speed = mc.speed();
-        
-    cmd.send(id, B_SUCCESS, ntob(speed), finger0_send);
+    force = mc.aforce();
+    seq = seq + 1;
+
+    -- Finger blocks: head (0 none, 1 sensor data, 2 FMF force) and data
+    cmd.send(id, B_SUCCESS, ntob(pos), ntob(speed), ntob(force), {1}, finger0_send, {0}, utob(seq), utob(tick));
        
 end
 
@@ -22,12 +22,26 @@ is_speed = false;
 B_SUCCESS = etob(E_SUCCESS);
 --------------------------------------
 
+---Sequence and device clock------------
+-- Appended to every response as two uint32 (little endian):
+-- sequence number and device tick [ms] at sampling time
+seq = 0;
+function utob(n)
+    n = n % 4294967296;
+    return {n % 256, math.floor(n / 256) % 256, math.floor(n / 65536) % 256, math.floor(n / 16777216) % 256};
+end
+----------------------------------------
+
 function process()
     id, payload = cmd.read();
     -- ==== Measurements (1) ====
     --busy = mc.busy()
     --blocked = mc.blocked()
+    tick = systimer();
     pos = mc.position();
+    speed = mc.speed();
+    force = mc.aforce();
+    seq = seq + 1;
     
     if id == 0xB2 then
         -- do_speed = hasbit(payload[1], 0x02);
@@ -52,7 +66,7 @@ function process()
   --     mc.stop(); is_speed = false;
   --  end   
         
-    cmd.send(id, B_SUCCESS, ntob(pos));
+    cmd.send(id, B_SUCCESS, ntob(pos), ntob(speed), ntob(force), utob(seq), utob(tick));
        
 end
 
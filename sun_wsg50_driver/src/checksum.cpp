@@ -74,7 +74,7 @@
  * corresponding to x^16 + x^12 + x^5 + 1
  */
 
-static const unsigned short CRC_TABLE_CCITT16[256] = {
+const unsigned short CRC_TABLE_CCITT16[256] = {
     0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
     0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
     0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
@@ -57,6 +57,7 @@
 #include "wsg_50/common.h"
 #include "wsg_50/msg.h"
 #include "wsg_50/cmd.h"
+#include "wsg_50/trace.h"
 
 #include "wsg_50/tcp.h"
 #include "wsg_50/udp.h"
@@ -78,6 +79,9 @@
 //------------------------------------------------------------------------
 
 static bool connected = false;
+static cmd_submit_hook_t submit_hook = NULL;
+static cmd_send_hook_t send_hook = NULL;
+static cmd_observer_t observer = NULL;
 
 
 //------------------------------------------------------------------------
@@ -96,19 +100,11 @@ static bool connected = false;
 
 
 /**
- * Send command and wait for answer
- *
- * @param id		Command ID
- * @param len		Payload length
- * @param *payload	Payload data
- * @param pending	Flag indicating whether CMD_PENDING
- * 					is allowed return status
- *
- * @return Number of bytes received. -1 on error.
+ * Send command and wait for answer on the interface
  */
 
-int cmd_submit( unsigned char id, unsigned char *payload, unsigned int len,
-			    bool pending, unsigned char **response, unsigned int *response_len )
+static int cmd_exchange( unsigned char id, unsigned char *payload, unsigned int len,
+						 bool pending, unsigned char **response, unsigned int *response_len )
 {
 	//printf("CMD_SUBMIT-init\n");
 	int res;
@@ -122,14 +118,8 @@ int cmd_submit( unsigned char id, unsigned char *payload, unsigned int len,
 		.data = payload
 	};
 
-	// Check if we're connected
-	if ( !connected )
-	{
-		fprintf( stderr, "Interface not connected\n" );
-		return -1;
-	}
-
 	// Send command
+	WSG50_TRACE2( cmd_start, id, len );
 	res = msg_send( &msg );
 	if ( res < 0 )
 	{
@@ -173,10 +163,12 @@ int cmd_submit( unsigned char id, unsigned char *payload, unsigned int len,
 			}
 
 			status = (status_t) make_short( msg.data[0], msg.data[1] );
+			if ( status == E_CMD_PENDING ) WSG50_TRACE1( cmd_pending, id );
 		}
 	}
 	while( pending && status == E_CMD_PENDING );
 
+	WSG50_TRACE3( cmd_complete, id, pending ? (int) status : 0, msg.len );
 
 	// Return payload
 	*response_len = msg.len;
@@ -187,6 +179,112 @@ int cmd_submit( unsigned char id, unsigned char *payload, unsigned int len,
 }
 
 
+/**
+ * Send command and wait for answer
+ *
+ * @param id		Command ID
+ * @param len		Payload length
+ * @param *payload	Payload data
+ * @param pending	Flag indicating whether CMD_PENDING
+ * 					is allowed return status
+ *
+ * @return Number of bytes received. -1 on error.
+ */
+
+int cmd_submit( unsigned char id, unsigned char *payload, unsigned int len,
+			    bool pending, unsigned char **response, unsigned int *response_len )
+{
+	int res;
+
+	// Check if we're connected
+	if ( !connected )
+	{
+		fprintf( stderr, "Interface not connected\n" );
+		return -1;
+	}
+
+	// Responses are read elsewhere (see dispatch.h)
+	if ( submit_hook ) res = submit_hook( id, payload, len, pending, response, response_len );
+	else res = cmd_exchange( id, payload, len, pending, response, response_len );
+
+	if ( observer ) observer( id, payload, len, res, res > 0 ? *response : NULL );
+	return res;
+}
+
+
+/**
+ * Send command without waiting for the answer, which is read elsewhere
+ * (or dropped by the reader thread, see dispatch.h)
+ *
+ * @param id		Command ID
+ * @param len		Payload length
+ * @param *payload	Payload data
+ * @param pending	Flag indicating whether CMD_PENDING
+ * 					is allowed return status
+ *
+ * @return Number of bytes sent. -1 on error.
+ */
+
+int cmd_send( unsigned char id, unsigned char *payload, unsigned int len, bool pending )
+{
+	if ( !connected )
+	{
+		fprintf( stderr, "Interface not connected\n" );
+		return -1;
+	}
+
+	if ( send_hook ) return send_hook( id, payload, len, pending );
+
+	msg_t msg =
+	{
+		.id = id,
+		.len = len,
+		.data = payload
+	};
+	return msg_send( &msg );
+}
+
+
+/**
+ * Install a hook that replaces sending and receiving in cmd_submit(),
+ * used when another thread owns the receiving side of the interface.
+ *
+ * @param hook		Hook function, NULL restores the default behaviour
+ */
+
+void cmd_set_submit_hook( cmd_submit_hook_t hook )
+{
+	submit_hook = hook;
+}
+
+
+/**
+ * Install a hook that replaces cmd_send(), used together with the
+ * submit hook
+ *
+ * @param hook		Hook function, NULL restores the default behaviour
+ */
+
+void cmd_set_send_hook( cmd_send_hook_t hook )
+{
+	send_hook = hook;
+}
+
+
+/**
+ * Install a function that is told about every command exchange, e.g. to
+ * record them. It runs in the thread calling cmd_submit(), cmd_send()
+ * is not reported.
+ *
+ * @param observer_fn	Observer function, NULL removes it
+ */
+
+void cmd_set_observer( cmd_observer_t observer_fn )
+{
+	observer = observer_fn;
+}
+
+
 /**
  * Open TCP connection
  *
@@ -314,6 +412,36 @@ int cmd_connect_serial( const char *device, unsigned int bitrate )
 }
 
 
+/**
+ * Open up connection over a user supplied interface
+ * (e.g. an in-memory interface for benchmarks)
+ *
+ * @param *iface		Interface struct
+ * @param *params		Parameters passed to the interface's open function
+ *
+ * @return 0 on success, else -1
+ */
+
+int cmd_connect_interface( const interface_t *iface, const void *params )
+{
+	int res;
+
+	if ( !iface ) return -1;
+
+	// If already connected, return error
+	if ( connected ) return -1;
+
+	// Open connection
+	res = msg_open( iface, params );
+	if ( res < 0 ) return -1;
+
+	// Set connected flag
+	connected = true;
+
+	return 0;
+}
+
+
 /**
  * Disconnect
  */
@@ -339,6 +467,7 @@ void cmd_disconnect( void )
 	if ( res > 0 ) free( resp );
 
 	msg_close();
+	connected = false;
 }
 
 
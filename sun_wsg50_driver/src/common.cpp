@@ -189,7 +189,10 @@ const char * getStateValues( unsigned char *b ){
 	dbgPrint("b[5] = 0x%x\n", b[5]);
 	*/
 
-	char resp[1024] = "| ";
+	// Per thread: the returned string outlives this call, and the reader
+	// thread and the service threads don't overwrite each other's text
+	static thread_local char resp[1024];
+	strcpy(resp, "| ");
 
 	if (b[2] & 0x1){	// D0 ==> LSB
 		//dbgPrint("Fingers Referenced.\n");
@@ -294,6 +297,32 @@ const char * getStateValues( unsigned char *b ){
 }
 
 
+/**
+ * System state bitmask of a GET SYSTEM STATE response
+ *
+ * @param *b	Response payload, status in b[0..1], bitmask in b[2..5]
+ */
+
+unsigned int stateFlags( const unsigned char *b )
+{
+	return (unsigned int) b[2] | ( (unsigned int) b[3] << 8 ) | ( (unsigned int) b[4] << 16 ) | ( (unsigned int) b[5] << 24 );
+}
+
+
+/**
+ * Readable form of a system state bitmask, see getStateValues().
+ * Valid until the next call in the same thread.
+ */
+
+const char * getStateText( unsigned int flags )
+{
+	unsigned char b[6] = { 0, 0,
+		(unsigned char) ( flags & 0xff ), (unsigned char) ( ( flags >> 8 ) & 0xff ),
+		(unsigned char) ( ( flags >> 16 ) & 0xff ), (unsigned char) ( ( flags >> 24 ) & 0xff ) };
+	return getStateValues( b );
+}
+
+
 //------------------------------------------------------------------------
 // Testing functions
 //------------------------------------------------------------------------
@@ -0,0 +1,289 @@
+//======================================================================
+/**
+ *  @file
+ *  dispatch.cpp
+ *
+ *  @section dispatch.cpp_general General file information
+ *
+ *  @brief
+ *  Response dispatching for a reader thread that owns the interface.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section dispatch.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "wsg_50/common.h"
+#include "wsg_50/cmd.h"
+#include "wsg_50/msg.h"
+#include "wsg_50/dispatch.h"
+#include "wsg_50/trace.h"
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+// A command waiting for its response(s), in send order per command ID
+typedef struct
+{
+	bool pending;					// E_CMD_PENDING responses precede the final one
+	bool discard;					// Sent by cmd_send(): responses stay with the reader, entry owned by the queue
+	double sent;					// Monotonic send time [s]
+	std::deque<msg_t> frames;		// Delivered, not yet taken by the waiting command
+} request;
+
+
+//------------------------------------------------------------------------
+// Global variables
+//------------------------------------------------------------------------
+
+static std::mutex send_mutex;				// Queue order = order on the wire
+static std::mutex queue_mutex;				// Protects everything below
+static std::condition_variable queue_cv;
+static std::deque<request *> queues[256];	// Requests per command ID
+static bool enabled = false;
+static double timeout_s = 30.0;
+
+
+//------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------
+
+static double now_s( void )
+{
+	return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+static void free_frames( request *req )
+{
+	while ( !req->frames.empty() )
+	{
+		msg_free( &req->frames.front() );
+		req->frames.pop_front();
+	}
+}
+
+
+/** \brief Take a request out of its queue (queue_mutex held) */
+static void remove_request( unsigned char id, request *req )
+{
+	std::deque<request *> &queue = queues[id];
+
+	for ( std::deque<request *>::iterator it = queue.begin(); it != queue.end(); ++it )
+	{
+		if ( *it == req )
+		{
+			queue.erase( it );
+			return;
+		}
+	}
+}
+
+
+/** \brief Queue a request and send its command */
+static int send_request( unsigned char id, unsigned char *payload, unsigned int len, request *req )
+{
+	std::lock_guard<std::mutex> send_lock( send_mutex );
+	msg_t msg;
+
+	{
+		std::lock_guard<std::mutex> lock( queue_mutex );
+		if ( !enabled ) return -1;
+		req->sent = now_s();
+		queues[id].push_back( req );
+	}
+
+	msg.id = id; msg.len = len; msg.data = payload;
+	int res = msg_send( &msg );
+	if ( res < 0 )
+	{
+		fprintf( stderr, "Message send failed\n" );
+		std::lock_guard<std::mutex> lock( queue_mutex );
+		remove_request( id, req );
+	}
+	return res;
+}
+
+
+/**
+ * cmd_submit() replacement: send the command, wait for the reader
+ * thread to deliver the response(s)
+ */
+
+static int dispatch_submit( unsigned char id, unsigned char *payload, unsigned int len,
+							bool pending, unsigned char **response, unsigned int *response_len )
+{
+	status_t status = E_SUCCESS;
+	request req;
+	msg_t msg;
+
+	req.pending = pending;
+	req.discard = false;
+
+	WSG50_TRACE2( cmd_start, id, len );
+
+	if ( send_request( id, payload, len, &req ) < 0 ) return -1;
+
+	// Wait for response. Repeat if pending.
+	do
+	{
+		{
+			std::unique_lock<std::mutex> lock( queue_mutex );
+			queue_cv.wait_for( lock, std::chrono::duration<double>( timeout_s ),
+							   [&req] { return !req.frames.empty() || !enabled; } );
+			if ( req.frames.empty() )
+			{
+				remove_request( id, &req );
+				lock.unlock();
+				fprintf( stderr, "No response to command %02x\n", id );
+				return -1;
+			}
+			msg = req.frames.front();
+			req.frames.pop_front();
+		}
+
+		if ( pending )
+		{
+			if ( msg.len < 2 )
+			{
+				fprintf( stderr, "No status code received\n" );
+				msg_free( &msg );
+				std::lock_guard<std::mutex> lock( queue_mutex );
+				remove_request( id, &req );
+				free_frames( &req );
+				return -1;
+			}
+
+			status = (status_t) make_short( msg.data[0], msg.data[1] );
+			if ( status == E_CMD_PENDING )
+			{
+				WSG50_TRACE1( cmd_pending, id );
+				msg_free( &msg );
+			}
+		}
+	}
+	while ( pending && status == E_CMD_PENDING );
+
+	// The final response took the request out of its queue
+	{
+		std::lock_guard<std::mutex> lock( queue_mutex );
+		free_frames( &req );
+	}
+	WSG50_TRACE3( cmd_complete, id, pending ? (int) status : 0, msg.len );
+
+	// Return payload, owned by the caller
+	*response_len = msg.len;
+	if ( msg.len > 0 ) *response = msg.data;
+	else
+	{
+		*response = 0;
+		msg_free( &msg );
+	}
+
+	return (int) msg.len;
+}
+
+
+/** \brief cmd_send() replacement: send, the response(s) are left to the reader thread */
+static int dispatch_send( unsigned char id, unsigned char *payload, unsigned int len, bool pending )
+{
+	request *req = new request;
+
+	req->pending = pending;
+	req->discard = true;
+
+	int res = send_request( id, payload, len, req );
+	if ( res < 0 ) delete req;
+	return res;
+}
+
+
+void dispatch_enable( double timeout )
+{
+	std::lock_guard<std::mutex> lock( queue_mutex );
+
+	timeout_s = timeout;
+	enabled = true;
+	cmd_set_submit_hook( dispatch_submit );
+	cmd_set_send_hook( dispatch_send );
+}
+
+
+void dispatch_disable( void )
+{
+	{
+		std::lock_guard<std::mutex> lock( queue_mutex );
+
+		enabled = false;
+		cmd_set_submit_hook( NULL );
+		cmd_set_send_hook( NULL );
+
+		// Waiting commands fail and find their request gone
+		for ( int id = 0; id < 256; id++ )
+		{
+			for ( size_t i = 0; i < queues[id].size(); i++ )
+				if ( queues[id][i]->discard ) delete queues[id][i];
+			queues[id].clear();
+		}
+	}
+	queue_cv.notify_all();
+}
+
+
+bool dispatch_deliver( msg_t *msg )
+{
+	{
+		std::lock_guard<std::mutex> lock( queue_mutex );
+		std::deque<request *> &queue = queues[msg->id];
+
+		if ( !enabled ) return false;
+
+		// Send-only commands whose response never came don't take the next one's
+		double now = now_s();
+		while ( !queue.empty() && queue.front()->discard && now - queue.front()->sent > timeout_s )
+		{
+			delete queue.front();
+			queue.pop_front();
+		}
+		if ( queue.empty() ) return false;
+
+		// Responses of one ID come in send order: the oldest request gets it,
+		// and leaves the queue with its final (not pending) response
+		request *req = queue.front();
+		bool final = !req->pending || msg->len < 2 ||
+					 (status_t) make_short( msg->data[0], msg->data[1] ) != E_CMD_PENDING;
+		if ( final ) queue.pop_front();
+
+		// Responses to cmd_send() stay with the reader thread
+		if ( req->discard )
+		{
+			if ( final ) delete req;
+			return false;
+		}
+
+		req->frames.push_back( *msg );
+		msg->data = NULL;
+	}
+	queue_cv.notify_all();
+
+	return true;
+}
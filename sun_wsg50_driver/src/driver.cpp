@@ -0,0 +1,1831 @@
+/*
+ * WSG 50 ROS NODE FOR REFILLS PROJECT
+ * Copyright (c) 2012, Robotnik Automation, SLL
+ * Copyright 2018 Università della Campania Luigi Vanvitelli
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the copyright holders nor the names of their
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \author Marco Costanzo (marco.costanzo@unicampania.it)
+ * \brief WSG-50 ROS driver.
+ */
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "wsg_50/common.h"
+#include "wsg_50/cmd.h"
+#include "wsg_50/msg.h"
+#include "wsg_50/functions.h"
+#include "wsg_50/state_cache.h"
+#include "wsg_50/dispatch.h"
+#include "wsg_50/mailbox.h"
+#include "wsg_50/rate_controller.h"
+#include "wsg_50/timestamp.h"
+#include "wsg_50/clock_sync.h"
+#include "wsg_50/trace.h"
+#include "wsg_50/force_loop.h"
+#include "wsg_50/msg_reuse.h"
+#include "wsg_50/publish_filter.h"
+#include "wsg_50/sample_log.h"
+#include "wsg_50/flight_recorder.h"
+#include "wsg_50/state_estimator.h"
+#include "wsg_50/contact_detector.h"
+#include "wsg_50/tactile.h"
+#include "wsg_50/tactile_calibration.h"
+#include "wsg_50/driver.h"
+#include "wsg_50/driver_msgs.h"
+
+#include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <actionlib/server/simple_action_server.h>
+#include "std_msgs/String.h"
+#include "std_srvs/Empty.h"
+#include "std_srvs/SetBool.h"
+#include "sun_wsg50_common/Status.h"
+#include "sun_wsg50_common/StatusCompact.h"
+#include "sun_wsg50_common/StateEstimate.h"
+#include "sun_wsg50_common/ContactEvent.h"
+#include "sun_wsg50_common/Move.h"
+#include "sun_wsg50_common/Conf.h"
+#include "sun_wsg50_common/Incr.h"
+#include "sun_wsg50_common/Cmd.h"
+#include "sun_wsg50_common/GetState.h"
+#include "sun_wsg50_common/DumpRecorder.h"
+#include "sun_wsg50_common/ExchangeStats.h"
+#include "sun_wsg50_common/ClockStats.h"
+#include "sun_wsg50_common/CommandStats.h"
+#include "sun_wsg50_common/MoveAction.h"
+#include "sun_wsg50_common/HomingAction.h"
+
+#include "sensor_msgs/JointState.h"
+//#include "std_msgs/Float32.h"
+#include "sun_ros_msgs/Float64Stamped.h"
+#include "sun_wsg50_common/Tactile.h"
+#include "sun_wsg50_common/TactilePressure.h"
+#include "std_msgs/Bool.h"
+#include "std_msgs/Float64.h"
+#include "std_msgs/UInt32.h"
+
+using namespace std;
+
+
+//------------------------------------------------------------------------
+// Local macros
+//------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+#define GRIPPER_MAX_OPEN 110.0
+#define GRIPPER_MIN_OPEN 0.0
+
+// System state bits that trigger the flight recorder: fast stop, temperature,
+// power, engine current and finger faults, command and script errors
+#define STATE_FAULT_FLAGS 0x17D000
+
+//------------------------------------------------------------------------
+// Global variables
+//------------------------------------------------------------------------
+
+float increment;
+bool objectGraspped;
+
+int g_timer_cnt = 0;
+ros::Publisher g_pub_state, g_pub_joint, g_pub_moving, g_pub_distnce, g_pub_tactile;
+// Mode flags are read by read_thread() and the callback threads, cleared by driver_stop()
+bool g_ismoving = false;
+std::atomic<bool> g_mode_script(false), g_mode_periodic(false), g_mode_polling(false);
+std::atomic<bool> g_mode_streaming(false);  // auto_update + services, responses are dispatched by read_thread()
+float g_speed = 10.0;
+
+// Latest goals from the topics, taken once per exchange with the gripper
+struct position_goal { float pos, speed; };
+Mailbox<position_goal> g_position_box;
+Mailbox<float> g_speed_box;
+
+// Adaptive loop rate (script and polling modes)
+bool g_adaptive_rate = false;
+RateController g_rate_ctrl;
+ros::Timer g_loop_timer;
+ros::Publisher g_pub_rate, g_pub_overruns;
+
+ros::Publisher g_pub_exchange, g_pub_clock, g_pub_command_stats;
+std::string joint_prefix;
+double g_cache_max_age = 0.05;  // Max. age of cached state used instead of a round trip [s]
+double g_response_timeout = 30.0;  // Streaming mode: max. wait for each response frame [s]
+
+// System state bitmask; its text is rebuilt and published (latched) only when it changes
+ros::Publisher g_pub_state_compact, g_pub_state_text;
+std::atomic<unsigned int> g_state_flags(0);
+bool g_state_known = false;
+std::string g_state_text;
+double g_state_period = 1.0;  // Script mode: period of the system state query [s], 0 disables
+ros::Timer g_state_timer;
+
+// Grasp force control in the I/O loop (script mode)
+bool g_force_control = false;
+std::atomic<bool> g_force_running(false);
+ForceLoop g_force_loop;
+double g_force_ref = 0.0, g_force_meas = 0.0;
+double g_force_meas_at = 0.0;  // Monotonic receive time of the measure [s]
+double g_force_last = 0.0;  // Monotonic time of the last control cycle [s]
+double g_force_timeout = 0.1;  // Max. age of the measure, zero speed beyond [s]
+ros::Time g_force_meas_stamp;
+ros::Publisher g_pub_force_latency;
+ros::Subscriber g_sub_force, g_sub_force_cmd;
+
+// Motion action servers (streaming mode)
+typedef actionlib::SimpleActionServer<sun_wsg50_common::MoveAction> MoveActionServer;
+typedef actionlib::SimpleActionServer<sun_wsg50_common::HomingAction> HomingActionServer;
+std::unique_ptr<MoveActionServer> g_move_action, g_grasp_action, g_release_action;
+std::unique_ptr<HomingActionServer> g_homing_action;
+// Goal, cancel and preempt callbacks have their own queue and thread: a cancel reaches
+// isPreemptRequested() even while a blocking service holds the other queues
+ros::CallbackQueue g_action_queue;
+std::unique_ptr<ros::AsyncSpinner> g_action_spinner;
+double g_feedback_period = 0.05;  // [s]
+
+// Per-topic decimation and deadbands (timer_cb() and read_thread())
+PublishFilter g_filter_status, g_filter_compact, g_filter_width, g_filter_joint;
+
+// Binary log of every device sample (timer_cb() or read_thread())
+SampleLog g_sample_log;
+
+// Flight recorder: the last seconds of samples and commands, dumped on request or on faults
+FlightRecorder g_recorder;
+bool g_recorder_enabled = false, g_recorder_auto = false;
+std::string g_recorder_dir;
+unsigned long g_crc_errors = 0;
+std::future<void> g_recorder_dump;
+
+// Opening estimator, fed by the samples, published by estimator_thread() above the device rate
+StateEstimator g_estimator;
+bool g_estimator_enabled = false;
+std::atomic<bool> g_estimator_running(false);
+ros::Publisher g_pub_joint_est, g_pub_estimate;
+
+// Contact detection during speed commands in script mode, evaluated by timer_cb() on every sample
+typedef enum { CONTACT_ACTION_NONE, CONTACT_ACTION_STOP, CONTACT_ACTION_FORCE } contact_action_t;
+ContactDetector g_contact;
+bool g_contact_enabled = false;
+contact_action_t g_contact_action = CONTACT_ACTION_STOP;
+std::atomic<float> g_speed_command(0.0);    // Speed the fingers follow [mm/s], 0 after a position goal or stop
+std::atomic<float> g_contact_latched(0.0);  // Direction of the stopped motion, speed commands towards it are held
+ros::Publisher g_pub_contact;
+
+// Calibrated finger sensor data (script mode)
+TactileCalibration g_tactile_cal;
+bool g_tactile_force = false;    // The grasp force is the force control/contact measure
+ros::Publisher g_pub_pressure;
+
+// Messages of timer_cb(), allocated once
+ReusedMessage<sun_wsg50_common::StatusPtr> g_status_msg;
+ReusedMessage<sun_wsg50_common::StatusCompactPtr> g_compact_msg;
+ReusedMessage<sun_ros_msgs::Float64StampedPtr> g_width_msg, g_latency_msg;
+ReusedMessage<sensor_msgs::JointStatePtr> g_joint_msg, g_joint_est_msg;
+ReusedMessage<sun_wsg50_common::StateEstimatePtr> g_estimate_msg;
+ReusedMessage<sun_wsg50_common::TactilePtr> g_tactile_msg;
+ReusedMessage<sun_wsg50_common::TactilePressurePtr> g_pressure_msg;
+
+// Handles created by driver_start(), released by driver_stop()
+std::vector<ros::ServiceServer> g_services;
+ros::Subscriber g_sub_position, g_sub_speed;
+ros::Timer g_command_timer;
+std::thread g_read_thread, g_estimator_thread;
+
+// Streaming mode: stop, ack, goal_position and command_cb() are served by their own queue and
+// thread, so a motion service blocking the queue of the node handles does not hold them up
+ros::CallbackQueue g_control_queue;
+std::unique_ptr<ros::AsyncSpinner> g_control_spinner;
+   
+//------------------------------------------------------------------------
+// Unit testing
+//------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------
+// Local function prototypes
+//------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------
+
+
+bool moveSrv(sun_wsg50_common::Move::Request &req, sun_wsg50_common::Move::Response &res)
+{
+	if ( (req.width >= 0.0 && req.width <= 110.0) && (req.speed > 0.0 && req.speed <= 420.0) ){
+  		ROS_INFO("Moving to %f position at %f mm/s.", req.width, req.speed);
+		res.error = move(req.width, req.speed, false);
+	}else if (req.width < 0.0 || req.width > 110.0){
+		ROS_ERROR("Imposible to move to this position. (Width values: [0.0 - 110.0] ");
+		res.error = 255;
+		return false;
+	}else{
+	        ROS_WARN("Speed values are outside the gripper's physical limits ([0.1 - 420.0])  Using clamped values.");
+		res.error = move(req.width, req.speed, false);
+	}
+
+	ROS_INFO("Target position reached.");
+  	return true;
+}
+
+bool graspSrv(sun_wsg50_common::Move::Request &req, sun_wsg50_common::Move::Response &res)
+{
+	if ( (req.width >= 0.0 && req.width <= 110.0) && (req.speed > 0.0 && req.speed <= 420.0) ){
+        ROS_INFO("Grasping object at %f with %f mm/s.", req.width, req.speed);
+		res.error = grasp(req.width, req.speed);
+	}else if (req.width < 0.0 || req.width > 110.0){
+		ROS_ERROR("Imposible to move to this position. (Width values: [0.0 - 110.0] ");
+		res.error = 255;
+		return false;
+	}else{
+	        ROS_WARN("Speed or position values are outside the gripper's physical limits (Position: [0.0 - 110.0] / Speed: [0.1 - 420.0])  Using clamped values.");
+		res.error = grasp(req.width, req.speed);
+	}
+
+	ROS_INFO("Object grasped correctly.");
+	objectGraspped=true;
+  	return true;
+}
+
+bool incrementSrv(sun_wsg50_common::Incr::Request &req, sun_wsg50_common::Incr::Response &res)
+{
+	if (req.direction == "open"){
+	
+		if (!objectGraspped){
+		
+			float currentWidth = getOpeningCached(g_cache_max_age);
+			float nextWidth = currentWidth + req.increment;
+			if ( (currentWidth < GRIPPER_MAX_OPEN) && nextWidth < GRIPPER_MAX_OPEN ){
+				//grasp(nextWidth, 1);
+				move(nextWidth,20, true);
+				currentWidth = nextWidth;
+			}else if( nextWidth >= GRIPPER_MAX_OPEN){
+				//grasp(GRIPPER_MAX_OPEN, 1);
+				move(GRIPPER_MAX_OPEN,1, true);
+				currentWidth = GRIPPER_MAX_OPEN;
+			}
+		}else{
+			ROS_INFO("Releasing object...");
+			release(GRIPPER_MAX_OPEN, 20);
+			objectGraspped = false;
+		}
+	}else if (req.direction == "close"){
+	
+		if (!objectGraspped){
+
+			float currentWidth = getOpeningCached(g_cache_max_age);
+			float nextWidth = currentWidth - req.increment;
+		
+			if ( (currentWidth > GRIPPER_MIN_OPEN) && nextWidth > GRIPPER_MIN_OPEN ){
+				//grasp(nextWidth, 1);
+				move(nextWidth,20, true);
+				currentWidth = nextWidth;
+			}else if( nextWidth <= GRIPPER_MIN_OPEN){
+				//grasp(GRIPPER_MIN_OPEN, 1);
+				move(GRIPPER_MIN_OPEN,1, true);
+				currentWidth = GRIPPER_MIN_OPEN;
+			}
+		}
+	}
+	return true;
+}
+
+bool releaseSrv(sun_wsg50_common::Move::Request &req, sun_wsg50_common::Move::Response &res)
+{
+	if ( (req.width >= 0.0 && req.width <= 110.0) && (req.speed > 0.0 && req.speed <= 420.0) ){
+  		ROS_INFO("Releasing to %f position at %f mm/s.", req.width, req.speed);
+		res.error = release(req.width, req.speed);
+	}else if (req.width < 0.0 || req.width > 110.0){
+		ROS_ERROR("Imposible to move to this position. (Width values: [0.0 - 110.0] ");
+		res.error = 255;
+		return false;
+	}else{
+	        ROS_WARN("Speed or position values are outside the gripper's physical limits (Position: [0.0 - 110.0] / Speed: [0.1 - 420.0])  Using clamped values.");
+		res.error = release(req.width, req.speed);
+	}
+	ROS_INFO("Object released correctly.");
+  	return true;
+}
+
+bool homingSrv(std_srvs::Empty::Request &req, std_srvs::Empty::Request &res)
+{
+	ROS_INFO("Homing...");
+	homing();
+	ROS_INFO("Home position reached.");
+	return true;
+}
+
+bool stopSrv(std_srvs::Empty::Request &req, std_srvs::Empty::Request &res)
+{
+	ROS_WARN("Stop!");
+	stop();
+	g_estimator.command(ros::Time::now().toSec(), 0.0);
+	g_speed_command = 0.0;
+	ROS_WARN("Stopped.");
+	return true;
+}
+
+bool setAccSrv(sun_wsg50_common::Conf::Request &req, sun_wsg50_common::Conf::Response &res)
+{
+	setAcceleration(req.val);
+	return true;
+}
+
+bool setForceSrv(sun_wsg50_common::Conf::Request &req, sun_wsg50_common::Conf::Response &res)
+{
+	setGraspingForceLimit(req.val);
+	return true;
+}
+
+bool ackSrv(std_srvs::Empty::Request &req, std_srvs::Empty::Request &res)
+{
+	ack_fault();
+	return true;
+}
+
+/** \brief Opening, speed and force from the state cache, refreshed from the gripper if older than max_age */
+bool getStateSrv(sun_wsg50_common::GetState::Request &req, sun_wsg50_common::GetState::Response &res)
+{
+	double max_age = req.max_age > 0.0 ? req.max_age : g_cache_max_age;
+
+	res.width = getOpeningCached(max_age);
+	res.speed = getSpeedCached(max_age);
+	res.force = getForceCached(max_age);
+
+	gripper_state state = state_cache().snapshot();
+	double now = StateCache::now();
+	res.age = 0.0;
+	for (int i = 0; i < CACHE_FIELDS; i++)
+		res.age = std::max(res.age, (float)(now - state.stamp[i]));
+	res.error = 0;
+	return true;
+}
+
+/**
+ * Run a blocking motion command for an action server. The command waits
+ * for its final response in a worker thread, meanwhile the state stream
+ * (read_thread()) is published as feedback. Preemption sends STOP, which
+ * ends the command with E_CMD_ABORTED.
+ *
+ * @return Status of the command
+ */
+
+template <class Server>
+status_t execute_motion(Server &server, const char *name, std::function<int()> command)
+{
+    typename Server::Feedback feedback;
+    typename Server::Result result;
+    bool stopping = false;
+
+    std::future<status_t> done = std::async(std::launch::async, [command]() {
+        command();
+        return command_status();
+    });
+
+    while (done.wait_for(std::chrono::duration<double>(g_feedback_period)) != std::future_status::ready) {
+        if (!stopping && (server.isPreemptRequested() || !g_mode_streaming || !ros::ok())) {
+            ROS_WARN("%s preempted, stopping", name);
+            stop(true);
+            stopping = true;
+        }
+        gripper_state state = state_cache().snapshot();
+        feedback.width = state.value[CACHE_OPENING];
+        feedback.speed = state.value[CACHE_SPEED];
+        feedback.force = state.value[CACHE_FORCE];
+        server.publishFeedback(feedback);
+    }
+
+    status_t status = done.get();
+    result.status = status;
+    result.status_text = status_to_str(status);
+    result.width = state_cache().snapshot().value[CACHE_OPENING];
+    if (status == E_SUCCESS) {
+        ROS_INFO("%s done.", name);
+        server.setSucceeded(result);
+    } else if (stopping) {
+        server.setPreempted(result, result.status_text);
+    } else {
+        ROS_ERROR("%s failed: %s", name, result.status_text.c_str());
+        server.setAborted(result, result.status_text);
+    }
+    return status;
+}
+
+/** \brief Same limits as the services: width out of range aborts, speed is clamped by the gripper */
+bool accept_move_goal(MoveActionServer &server, const sun_wsg50_common::MoveGoalConstPtr &goal)
+{
+    if (goal->width < 0.0 || goal->width > 110.0) {
+        ROS_ERROR("Imposible to move to this position. (Width values: [0.0 - 110.0] ");
+        sun_wsg50_common::MoveResult result;
+        result.status = E_RANGE_ERROR;
+        result.status_text = status_to_str(E_RANGE_ERROR);
+        result.width = state_cache().snapshot().value[CACHE_OPENING];
+        server.setAborted(result, result.status_text);
+        return false;
+    }
+    if (goal->speed <= 0.0 || goal->speed > 420.0)
+        ROS_WARN("Speed values are outside the gripper's physical limits ([0.1 - 420.0])  Using clamped values.");
+    return true;
+}
+
+void moveActionCb(const sun_wsg50_common::MoveGoalConstPtr &goal)
+{
+    if (!accept_move_goal(*g_move_action, goal))
+        return;
+    ROS_INFO("Moving to %f position at %f mm/s.", goal->width, goal->speed);
+    execute_motion(*g_move_action, "Move", [goal]() { return move(goal->width, goal->speed, false); });
+}
+
+void graspActionCb(const sun_wsg50_common::MoveGoalConstPtr &goal)
+{
+    if (!accept_move_goal(*g_grasp_action, goal))
+        return;
+    ROS_INFO("Grasping object at %f with %f mm/s.", goal->width, goal->speed);
+    if (execute_motion(*g_grasp_action, "Grasp", [goal]() { return grasp(goal->width, goal->speed); }) == E_SUCCESS)
+        objectGraspped = true;
+}
+
+void releaseActionCb(const sun_wsg50_common::MoveGoalConstPtr &goal)
+{
+    if (!accept_move_goal(*g_release_action, goal))
+        return;
+    ROS_INFO("Releasing to %f position at %f mm/s.", goal->width, goal->speed);
+    if (execute_motion(*g_release_action, "Release", [goal]() { return release(goal->width, goal->speed); }) == E_SUCCESS)
+        objectGraspped = false;
+}
+
+void homingActionCb(const sun_wsg50_common::HomingGoalConstPtr &goal)
+{
+    ROS_INFO("Homing...");
+    execute_motion(*g_homing_action, "Homing", []() { return homing(); });
+}
+
+/** \brief Callback for goal_position topic (in appropriate modes) */
+void position_cb(const sun_wsg50_common::Cmd::ConstPtr& msg)
+{
+    g_speed = msg->speed;
+    position_goal goal = { msg->pos, msg->speed };
+    // Latest goal wins, timer_cb() (script) or command_cb() (auto_update, streaming)
+    // send it to the gripper once per cycle
+    g_position_box.post(goal);
+}
+
+/** \brief Callback for goal_speed topic (in appropriate modes) */
+void speed_cb(const sun_ros_msgs::Float64Stamped::ConstPtr& msg)
+{
+    g_speed = msg->data;
+    // timer_cb() will send command to gripper
+    g_speed_box.post(msg->data);
+}
+
+/** \brief Callback for the grasp force measure, used by the next timer_cb() cycle */
+void force_measure_cb(const sun_ros_msgs::Float64Stamped::ConstPtr& msg)
+{
+    g_force_meas = msg->data;
+    g_force_meas_at = StateCache::now();
+    g_force_meas_stamp = msg->header.stamp.isZero() ? ros::Time::now() : msg->header.stamp;
+}
+
+/** \brief Callback for the grasp force reference */
+void force_command_cb(const sun_ros_msgs::Float64Stamped::ConstPtr& msg)
+{
+    g_force_ref = fabs(msg->data);
+}
+
+/** \brief Start/pause the force control, the fingers stop on pause */
+bool forceRunningSrv(std_srvs::SetBool::Request &req, std_srvs::SetBool::Response &res)
+{
+    if (req.data && !g_force_running) {
+        g_force_loop.reset(g_force_ref);
+        g_force_last = 0.0;
+        ROS_INFO("Force control started");
+    } else if (!req.data && g_force_running) {
+        g_speed_box.post(0.0);
+        ROS_INFO("Force control paused");
+    }
+    g_force_running = req.data;
+    res.success = true;
+    return true;
+}
+
+/**
+ * Speed command [mm/s] of the force control for the exchange about to start.
+ * Uses the latest measure and reference and the opening of the last exchange.
+ */
+
+float force_control_speed()
+{
+    double now = StateCache::now();
+    double dt = g_force_last > 0.0 ? now - g_force_last : 0.0;
+    g_force_last = now;
+
+    if (now - g_force_meas_at > g_force_timeout) {
+        ROS_WARN_THROTTLE(1.0, "Force control: no force measure for %.3f s, holding", now - g_force_meas_at);
+        return 0.0;
+    }
+
+    double width = state_cache().snapshot().value[CACHE_OPENING] / 1000.0;  // [mm] to [m]
+    double speed = g_force_loop.update(g_force_ref, g_force_meas, width, dt);
+
+    switch (g_force_loop.state()) {
+        case FORCE_OVERLOAD:
+            ROS_WARN_THROTTLE(1.0, "Force control: measure %.2f N above the limit", g_force_meas);
+            break;
+        case FORCE_WIDTH_LIMIT:
+            ROS_WARN_THROTTLE(1.0, "Force control: opening %.4f m at the limit", width);
+            break;
+        case FORCE_INVALID:
+            ROS_ERROR_THROTTLE(1.0, "Force control: NaN/inf speed, sending zero");
+            break;
+        default:
+            break;
+    }
+    return (float) speed;
+}
+
+/** \brief Log how many setpoints were received, sent and coalesced (superseded before sending) */
+void log_command_stats(bool throttle)
+{
+    mailbox_stats pos = g_position_box.stats(), speed = g_speed_box.stats();
+    if (throttle)
+        ROS_DEBUG_THROTTLE(5.0, "Setpoints: position %lu received, %lu sent, %lu coalesced; speed %lu received, %lu sent, %lu coalesced",
+                           pos.posted, pos.taken, pos.coalesced, speed.posted, speed.taken, speed.coalesced);
+    else
+        ROS_INFO("Setpoints: position %lu received, %lu sent, %lu coalesced; speed %lu received, %lu sent, %lu coalesced",
+                 pos.posted, pos.taken, pos.coalesced, speed.posted, speed.taken, speed.coalesced);
+}
+
+/** \brief Sends the latest goal_position in modes auto_update and streaming, at the update rate. */
+void command_cb(const ros::TimerEvent& ev)
+{
+    position_goal goal;
+    if (!g_position_box.take(&goal))
+        return;
+
+    // Send command to gripper without waiting for a response
+    // read_thread() handles responses
+    // read/write may be simultaneous, therefore no mutex
+    stop(true);
+    if (move(goal.pos, goal.speed, false, true) != 0)
+        ROS_ERROR("Failed to send MOVE command");
+    else
+        g_estimator.command_position(ros::Time::now().toSec(), goal.pos, goal.speed);
+    log_command_stats(true);
+}
+
+/** \brief ROS time of the estimated sampling instant of a cached value (now if never sampled) */
+ros::Time sample_stamp(cache_field_t field)
+{
+	gripper_state state = state_cache().snapshot();
+	ros::Time now = ros::Time::now();
+
+	if (state.stamp[field] <= 0.0)
+		return now;
+	return now - ros::Duration(StateCache::now() - state.stamp[field]);
+}
+
+/** \brief Publish the round trip time distribution, the setpoint counts and, with the
+ *         measure scripts sending seq/tick, the device clock statistics, once per second */
+void publish_link_stats()
+{
+	static double last = 0.0;
+	static unsigned long dropped = 0;
+	double now = StateCache::now();
+
+	if (now - last < 1.0)
+		return;
+	last = now;
+
+	rtt_stats rtt = timestamp_model().stats();
+	sun_wsg50_common::ExchangeStats msg;
+	msg.header.stamp = ros::Time::now();
+	msg.count = rtt.count;
+	msg.window = rtt.window;
+	msg.rtt_min = rtt.min;
+	msg.rtt_p50 = rtt.p50;
+	msg.rtt_p90 = rtt.p90;
+	msg.rtt_p99 = rtt.p99;
+	msg.rtt_max = rtt.max;
+	msg.rtt_mean = rtt.mean;
+	msg.return_delay = rtt.return_delay;
+	g_pub_exchange.publish(msg);
+
+	if (g_pub_command_stats) {
+		mailbox_stats pos = g_position_box.stats(), speed = g_speed_box.stats();
+		sun_wsg50_common::CommandStats command_msg;
+		command_msg.header.stamp = msg.header.stamp;
+		command_msg.position_received = pos.posted;
+		command_msg.position_sent = pos.taken;
+		command_msg.position_coalesced = pos.coalesced;
+		command_msg.speed_received = speed.posted;
+		command_msg.speed_sent = speed.taken;
+		command_msg.speed_coalesced = speed.coalesced;
+		g_pub_command_stats.publish(command_msg);
+	}
+
+	clock_stats clk = clock_sync().stats();
+	if (clk.samples == 0)
+		return;
+	if (clk.dropped > dropped)
+		ROS_WARN("%lu script samples dropped (%lu in total)", clk.dropped - dropped, clk.dropped);
+	dropped = clk.dropped;
+
+	sun_wsg50_common::ClockStats clock_msg;
+	clock_msg.header.stamp = msg.header.stamp;
+	clock_msg.samples = clk.samples;
+	clock_msg.dropped = clk.dropped;
+	clock_msg.duplicated = clk.duplicated;
+	clock_msg.resets = clk.resets;
+	clock_msg.offset = clk.offset;
+	clock_msg.drift_ppm = clk.drift * 1e6;
+	clock_msg.period = clk.period;
+	clock_msg.jitter = clk.jitter;
+	clock_msg.residual = clk.residual;
+	g_pub_clock.publish(clock_msg);
+}
+
+/** \brief Adapt the timer period to the measured exchange time, publish rate and overruns on change */
+void adapt_rate(double rtt, double duration)
+{
+	unsigned long overruns = g_rate_ctrl.overruns();
+
+	if (g_rate_ctrl.update(rtt, duration)) {
+		g_loop_timer.setPeriod(ros::Duration(g_rate_ctrl.period()), false);
+		ROS_DEBUG("Loop rate %.1f Hz (rtt %.2f ms +- %.2f ms)", g_rate_ctrl.rate(),
+		          g_rate_ctrl.srtt() * 1000.0, g_rate_ctrl.rttvar() * 1000.0);
+		std_msgs::Float64 rate_msg;
+		rate_msg.data = g_rate_ctrl.rate();
+		g_pub_rate.publish(rate_msg);
+	}
+	if (g_rate_ctrl.overruns() != overruns) {
+		std_msgs::UInt32 overruns_msg;
+		overruns_msg.data = g_rate_ctrl.overruns();
+		g_pub_overruns.publish(overruns_msg);
+	}
+}
+
+/** \brief Read publish/<name>/{decimation, width_deadband, force_deadband, max_period} */
+void load_publish_filter(ros::NodeHandle &nh, const std::string &name, PublishFilter &filter)
+{
+	publish_filter_params params = filter.params();
+	std::string ns = "publish/" + name + "/";
+	nh.param(ns + "decimation", params.decimation, params.decimation);
+	nh.param(ns + "width_deadband", params.width_deadband, params.width_deadband);
+	nh.param(ns + "force_deadband", params.force_deadband, params.force_deadband);
+	nh.param(ns + "max_period", params.max_period, params.max_period);
+	filter.set_params(params);
+}
+
+/** \brief Default base name of flight recorder dumps: directory/wsg50_flight_<local time> */
+std::string recorder_base_name()
+{
+	char name[64];
+	time_t now = time(NULL);
+	struct tm local;
+	localtime_r(&now, &local);
+	strftime(name, sizeof(name), "wsg50_flight_%Y%m%d-%H%M%S", &local);
+	return g_recorder_dir + "/" + name;
+}
+
+/** \brief Arm an automatic flight recorder dump */
+void trigger_recorder(double now, const std::string &reason)
+{
+	if (g_recorder_enabled && g_recorder_auto && g_recorder.trigger(now, reason))
+		ROS_WARN("Flight recorder triggered: %s", reason.c_str());
+}
+
+/** \brief Write the flight recorder to disk, runs in the background */
+void dump_recorder(std::string reason)
+{
+	std::vector<sample_record> samples;
+	std::vector<command_record> commands;
+	std::vector<std::string> files;
+	g_recorder.snapshot(StateCache::now(), samples, commands);
+	std::string base = recorder_base_name();
+	if (FlightRecorder::write(base, samples, commands, ros::Time::now().toSec(), files) == 0)
+		ROS_WARN("Flight recorder (%s): %zu samples, %zu commands written to %s.wlog",
+		         reason.c_str(), samples.size(), commands.size(), base.c_str());
+	else
+		ROS_ERROR("Flight recorder (%s): unable to write %s: %s", reason.c_str(), base.c_str(), strerror(errno));
+}
+
+/** \brief Dump the flight recorder to disk and/or return its records */
+bool dumpRecorderSrv(sun_wsg50_common::DumpRecorder::Request &req, sun_wsg50_common::DumpRecorder::Response &res)
+{
+	std::vector<sample_record> samples;
+	std::vector<command_record> commands;
+	g_recorder.snapshot(StateCache::now(), samples, commands);
+
+	char message[128];
+	snprintf(message, sizeof(message), "%zu samples, %zu commands", samples.size(), commands.size());
+	res.success = true;
+	res.message = message;
+
+	if (req.write_files) {
+		std::string base = req.path.empty() ? recorder_base_name() : req.path;
+		if (FlightRecorder::write(base, samples, commands, ros::Time::now().toSec(), res.files) != 0) {
+			res.success = false;
+			res.message = base + ": " + strerror(errno);
+		}
+	}
+
+	if (req.return_records) {
+		res.samples.resize(samples.size());
+		for (size_t i = 0; i < samples.size(); i++) {
+			const sample_record &r = samples[i];
+			sun_wsg50_common::RecorderSample &m = res.samples[i];
+			m.stamp = r.stamp;
+			m.received = r.received;
+			m.seq = r.seq;
+			m.device_ms = r.device_ms;
+			m.state = r.state;
+			m.flags = r.flags;
+			m.position = r.position;
+			m.speed = r.speed;
+			m.force = r.force;
+			m.force_finger0 = r.force_finger0;
+			m.force_finger1 = r.force_finger1;
+			std::copy(r.tactile0, r.tactile0 + 25, m.tactile0.begin());
+			std::copy(r.tactile1, r.tactile1 + 25, m.tactile1.begin());
+		}
+		res.commands.resize(commands.size());
+		for (size_t i = 0; i < commands.size(); i++) {
+			const command_record &c = commands[i];
+			sun_wsg50_common::RecorderCommand &m = res.commands[i];
+			m.time = c.time;
+			m.id = c.id;
+			m.len = c.len;
+			m.result = c.result;
+			m.status = c.status;
+			m.payload.assign(c.payload, c.payload + std::min<size_t>(c.len, sizeof(c.payload)));
+		}
+	}
+	return true;
+}
+
+/** \brief cmd_submit() observer: records the exchange, failures trigger the flight recorder */
+void record_command(unsigned char id, const unsigned char *payload, unsigned int len,
+                    int result, const unsigned char *response)
+{
+	if (!g_recorder_enabled)
+		return;
+
+	command_record record;
+	memset(&record, 0, sizeof(record));
+	record.time = StateCache::now();
+	record.id = id;
+	record.len = len;
+	record.result = result;
+	record.status = (result >= 2 && response) ? make_short(response[0], response[1]) : E_CMD_FAILED;
+	if (payload)
+		memcpy(record.payload, payload, std::min<size_t>(len, sizeof(record.payload)));
+	g_recorder.command(record);
+
+	if (record.status == E_AXIS_BLOCKED || record.status == E_CMD_FAILED) {
+		char reason[64];
+		snprintf(reason, sizeof(reason), "command 0x%02X: %s", id, status_to_str((status_t)record.status));
+		trigger_recorder(record.time, reason);
+	}
+}
+
+/** \brief Pass a decoded sample to the binary log and the flight recorder */
+void record_sample(const ros::Time &stamp, const gripper_response &info)
+{
+	if (!g_sample_log.is_open() && !g_recorder_enabled)
+		return;
+
+	sample_record record;
+	memset(&record, 0, sizeof(record));
+	record.stamp = stamp.toSec();
+	record.received = StateCache::now();
+	if (info.has_clock) {
+		record.flags |= SAMPLE_HAS_CLOCK;
+		record.seq = info.seq;
+		record.device_ms = info.device_ms;
+	}
+	if (g_state_known) {
+		record.flags |= SAMPLE_HAS_STATE;
+		record.state = g_state_flags;
+	}
+	record.position = info.position;
+	record.speed = info.speed;
+	record.force = info.f_motor;
+	record.force_finger0 = info.f_finger0;
+	record.force_finger1 = info.f_finger1;
+	if (info.tact_finger0) {
+		record.flags |= SAMPLE_TACTILE0;
+		memcpy(record.tactile0, info.v_finger0, sizeof(record.tactile0));
+	}
+	if (info.tact_finger1) {
+		record.flags |= SAMPLE_TACTILE1;
+		memcpy(record.tactile1, info.v_finger1, sizeof(record.tactile1));
+	}
+	g_sample_log.append(record);
+
+	if (!g_recorder_enabled)
+		return;
+	g_recorder.sample(record);
+
+	unsigned long crc_errors = msg_checksum_errors();
+	if (crc_errors != g_crc_errors) {
+		g_crc_errors = crc_errors;
+		trigger_recorder(record.received, "checksum error");
+	}
+
+	// Disk writes stay out of the I/O loop; a dump still being written delays the next one
+	std::string reason;
+	bool writing = g_recorder_dump.valid() &&
+	               g_recorder_dump.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+	if (!writing && g_recorder.due(record.received, reason))
+		g_recorder_dump = std::async(std::launch::async, dump_recorder, reason);
+}
+
+/**
+ * Publish the estimated joint state and the estimator state at a fixed rate,
+ * predicted to the publishing instant. A thread of its own: the callback queue
+ * is blocked by the exchanges of timer_cb().
+ */
+void estimator_thread(double rate)
+{
+	const std::chrono::steady_clock::duration period =
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rate));
+	std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+	state_estimate estimate;
+
+	while (g_estimator_running) {
+		next += period;
+		std::this_thread::sleep_until(next);
+		if (std::chrono::steady_clock::now() > next + period)
+			next = std::chrono::steady_clock::now();  // Overrun, don't catch up
+
+		ros::Time now = ros::Time::now();
+		if (!g_estimator.predict(now.toSec(), &estimate))
+			continue;
+
+		if (g_pub_joint_est.getNumSubscribers() > 0) {
+			const sensor_msgs::JointStatePtr &joint_states = g_joint_est_msg.get();
+			joint_states->header.stamp = now;
+			joint_states->position[0] = estimate.position/1000.0;
+			joint_states->velocity[0] = estimate.velocity/1000.0;
+			joint_states->effort[0] = state_cache().snapshot().value[CACHE_FORCE];
+			g_pub_joint_est.publish(joint_states);
+		}
+
+		if (g_pub_estimate.getNumSubscribers() > 0) {
+			const sun_wsg50_common::StateEstimatePtr &msg = g_estimate_msg.get();
+			msg->header.stamp = now;
+			msg->position = estimate.position/1000.0;
+			msg->velocity = estimate.velocity/1000.0;
+			for (int i = 0; i < 4; i++)
+				msg->covariance[i] = estimate.covariance[i]/1.0E6;
+			msg->prediction = estimate.prediction;
+			msg->innovation_position = estimate.innovation_position/1000.0;
+			msg->innovation_velocity = estimate.innovation_velocity/1000.0;
+			msg->innovation_rms = estimate.innovation_rms/1000.0;
+			msg->nis = estimate.nis;
+			msg->samples = estimate.samples;
+			g_pub_estimate.publish(msg);
+		}
+	}
+}
+
+/** \brief Record the system state bitmask, its text is only rebuilt and published if it changed */
+void update_state_flags(unsigned int flags)
+{
+	if (g_state_known && flags == g_state_flags)
+		return;
+	unsigned int raised = flags & ~(g_state_known ? g_state_flags.load() : 0) & STATE_FAULT_FLAGS;
+	g_state_flags = flags;
+	g_state_known = true;
+	g_state_text = getStateText(flags);
+
+	std_msgs::String text_msg;
+	text_msg.data = g_state_text;
+	g_pub_state_text.publish(text_msg);
+
+	if (raised)
+		trigger_recorder(StateCache::now(), "system state: " + std::string(getStateText(raised)));
+}
+
+/**
+ * Contact detected in timer_cb(): stop the fingers or hand over to the force control
+ * with one more exchange in the same cycle, then report the latencies.
+ *
+ * @param sources	CONTACT_* sources
+ * @param info		The detecting sample
+ * @param sampled	Its sampling instant, monotonic [s]
+ */
+
+void handle_contact(unsigned int sources, const gripper_response &info, double finger_force, double sampled)
+{
+	double t_detect = StateCache::now();
+	double stop_latency = 0.0;
+	float command = g_speed_command;
+	gripper_response stop_info;
+	const char *action = "none";
+
+	if (g_contact_action == CONTACT_ACTION_FORCE && g_force_control) {
+		action = "force_control";
+		g_force_loop.reset(g_force_ref);
+		g_force_last = 0.0;
+		g_force_running = true;
+		if (script_measure_move(2, 0, force_control_speed(), stop_info))
+			stop_latency = StateCache::now() - t_detect;
+		g_speed_command = 0.0;
+	} else if (g_contact_action != CONTACT_ACTION_NONE) {
+		action = "stop";
+		g_contact_latched = command;
+		if (script_measure_move(2, 0, 0.0, stop_info))
+			stop_latency = StateCache::now() - t_detect;
+		g_estimator.command(ros::Time::now().toSec(), 0.0);
+		g_speed_command = 0.0;
+	}
+	g_contact.reset();
+
+	ROS_INFO("Contact (%s%s%s) at %.1f mm, %s after %.1f ms + %.1f ms", (sources & CONTACT_FINGER) ? "finger " : "",
+	         (sources & CONTACT_FORCE) ? "force " : "", (sources & CONTACT_SPEED) ? "speed" : "", info.position,
+	         action, (t_detect - sampled) * 1000.0, stop_latency * 1000.0);
+
+	sun_wsg50_common::ContactEvent msg;
+	msg.header.stamp = ros::Time::now() - ros::Duration(t_detect - sampled);
+	msg.source = sources;
+	msg.action = action;
+	msg.width = info.position;
+	msg.speed = info.speed;
+	msg.command_speed = command;
+	msg.force = info.f_motor;
+	msg.finger_force = finger_force;
+	msg.detection_latency = t_detect - sampled;
+	msg.stop_latency = stop_latency;
+	g_pub_contact.publish(msg);
+}
+
+/** \brief Loop for state polling in modes script and polling. Also sends command in script mode. */
+void timer_cb(const ros::TimerEvent& ev)
+{
+	//printf("Timer \n");
+	// ==== Get state values by built-in commands ====
+	gripper_response info;
+	memset(&info, 0, sizeof(info));
+	float acc = 0.0;
+	info.speed = 0.0;
+	tactile_map tactile_maps[2];
+	bool calibrated[2] = { false, false };
+
+	double t_cycle = StateCache::now(), t_exchange = 0.0;
+
+    if (g_mode_polling) {
+		//printf("MODE_POLLING\n");
+        unsigned int flags;
+        if (systemStateFlags(&flags) != 0)
+            return;
+        update_state_flags(flags);
+        info.state = flags;
+		// The loop is what refreshes the cache: always a fresh sample here
+		info.position = getOpening();
+		acc = getAcceleration();
+		info.f_motor = getForce();//getGraspingForce();
+		t_exchange = StateCache::now() - t_cycle;
+
+    } else if (g_mode_script) {
+		//printf("MODE_SCRIPT\n");
+		// ==== Call custom measure-and-move command ====
+		int res = 0;
+		position_goal goal;
+		float goal_speed;
+		bool has_position = g_position_box.take(&goal);
+		bool has_speed = g_speed_box.take(&goal_speed);  // a position goal supersedes it
+		// The force control owns the speed while running, a position goal still supersedes it
+		bool force_cycle = g_force_control && g_force_running && !has_position;
+		ros::Time t_command;
+		if (force_cycle) {
+			goal_speed = force_control_speed();
+			has_speed = true;
+			t_command = ros::Time::now();
+		} else if (has_speed && g_contact_latched != 0.0) {
+			// After a contact stop, only a command away from the contact resumes the motion
+			if (goal_speed * g_contact_latched > 0.0)
+				goal_speed = 0.0;
+			else
+				g_contact_latched = 0.0;
+		}
+		if (has_position) {
+			g_speed_command = 0.0;
+			g_contact_latched = 0.0;
+		} else if (has_speed) {
+			g_speed_command = force_cycle ? 0.0 : goal_speed;
+		}
+		if (has_position) {
+			//printf("NOT NAN GOAL POSITION\n");
+			ROS_INFO("Position command: pos=%5.1f, speed=%5.1f", goal.pos, goal.speed);
+            res = script_measure_move(1, goal.pos, goal.speed, info);
+			g_estimator.command_position(ros::Time::now().toSec(), goal.pos, goal.speed);
+		} else if (has_speed) {
+			//printf("NOT NAN GOAL SPEED\n");
+			//ROS_INFO("Velocity command: speed=%5.1f", goal_speed);
+            		res = script_measure_move(2, 0, goal_speed, info);
+			g_estimator.command(ros::Time::now().toSec(), goal_speed);
+		} else{
+            		res = script_measure_move(0, 0, 0, info);
+			//printf("else02\n");
+		}
+		t_exchange = StateCache::now() - t_cycle;
+		if (has_position || (has_speed && !force_cycle))
+			log_command_stats(true);
+		if (force_cycle && res) {
+			// End-to-end latency: measure sampled -> speed command sent to the gripper
+			const sun_ros_msgs::Float64StampedPtr &latency_msg = g_latency_msg.get();
+			latency_msg->header.stamp = g_force_meas_stamp;
+			latency_msg->data = (t_command - g_force_meas_stamp).toSec();
+			g_pub_force_latency.publish(latency_msg);
+		}
+		//printf("CIAO\n");
+		if (!res) {
+			ROS_ERROR("Measure-and-move command failed");
+			return;
+		}
+		if (g_tactile_cal.loaded()) {
+			// Finger forces from the calibrated sensors, in the cycle of the sample
+			calibrated[0] = info.tact_finger0;
+			calibrated[1] = info.tact_finger1;
+			if (calibrated[0]) {
+				g_tactile_cal.apply(0, info.v_finger0, &tactile_maps[0]);
+				info.f_finger0 = tactile_maps[0].force;
+			}
+			if (calibrated[1]) {
+				g_tactile_cal.apply(1, info.v_finger1, &tactile_maps[1]);
+				info.f_finger1 = tactile_maps[1].force;
+			}
+			if (g_tactile_force && (calibrated[0] || calibrated[1])) {
+				g_force_meas = calibrated[0] && calibrated[1] ? (info.f_finger0 + info.f_finger1) / 2.0 :
+				               calibrated[0] ? info.f_finger0 : info.f_finger1;
+				g_force_meas_at = StateCache::now();
+				g_force_meas_stamp = sample_stamp(CACHE_OPENING);
+			}
+		}
+		if (g_contact_enabled && !(g_force_control && g_force_running)) {
+			// The finger force is the force control measure (the calibrated grasp force with tactile/force_measure)
+			double sampled = state_cache().snapshot().stamp[CACHE_OPENING];
+			double finger_force = StateCache::now() - g_force_meas_at <= g_force_timeout ? g_force_meas : NAN;
+			unsigned int sources = g_contact.update(sampled, g_speed_command, info.speed, info.f_motor, finger_force);
+			if (sources)
+				handle_contact(sources, info, finger_force, sampled);
+		}
+		//printf("CIAO2\n");
+		// ==== Moving msg ====
+		if (g_ismoving != info.ismoving) {
+			std_msgs::Bool moving_msg;
+			moving_msg.data = info.ismoving;
+			g_pub_moving.publish(moving_msg);
+			g_ismoving = info.ismoving;
+		} //printf("CIAO3\n");
+    } else
+        return;
+
+	// All messages carry the estimated sampling instant of the opening
+	ros::Time stamp = sample_stamp(CACHE_OPENING);
+	record_sample(stamp, info);
+	if (g_estimator_enabled)
+		g_estimator.update(stamp.toSec(), info.position, info.speed, g_mode_script);  // polling: no speed
+
+	// ==== Status msg ====
+	// Messages are reused (see msg_reuse.h), only values and stamps are written.
+	// Published by pointer: no serialization for subscribers in the same nodelet manager.
+	// Topics without subscribers are not even filled, the others pass their filter.
+	WSG50_TRACE1(publish_start, TRACE_LOOP_TIMER);
+	double t_publish = StateCache::now();
+	if (g_pub_state.getNumSubscribers() > 0 &&
+	    g_filter_status.update(t_publish, info.position, info.f_motor, g_state_flags)) {
+		const sun_wsg50_common::StatusPtr &status_msg = g_status_msg.get();
+		fill_status(*status_msg, stamp, g_state_text, info, acc);
+		g_pub_state.publish(status_msg);
+	}
+
+    if (g_pub_distnce.getNumSubscribers() > 0 &&
+        g_filter_width.update(t_publish, info.position, info.f_motor)) {
+        const sun_ros_msgs::Float64StampedPtr &distance_msg = g_width_msg.get();
+        fill_width(*distance_msg, stamp, info);
+        g_pub_distnce.publish(distance_msg);
+    }
+
+	// ==== Compact status msg ====
+	if (g_pub_state_compact.getNumSubscribers() > 0 &&
+	    g_filter_compact.update(t_publish, info.position, info.f_motor, g_state_flags)) {
+		const sun_wsg50_common::StatusCompactPtr &compact_msg = g_compact_msg.get();
+		fill_status_compact(*compact_msg, stamp, g_state_flags, info, acc);
+		g_pub_state_compact.publish(compact_msg);
+	}
+             
+
+	// ==== Joint state msg ====
+	if (g_pub_joint.getNumSubscribers() > 0 &&
+	    g_filter_joint.update(t_publish, info.position, info.f_motor)) {
+		const sensor_msgs::JointStatePtr &joint_states = g_joint_msg.get();
+		fill_joint_state(*joint_states, stamp, info);
+		g_pub_joint.publish(joint_states);
+	}
+
+	// ==== Tactile msg ====
+	if ((info.tact_finger0 || info.tact_finger1) && g_pub_tactile.getNumSubscribers() > 0) {
+		const sun_wsg50_common::TactilePtr &tactile_msg = g_tactile_msg.get();
+		fill_tactile(*tactile_msg, stamp, info);
+		g_pub_tactile.publish(tactile_msg);
+	}
+	if ((calibrated[0] || calibrated[1]) && g_pub_pressure.getNumSubscribers() > 0) {
+		const sun_wsg50_common::TactilePressurePtr &pressure_msg = g_pressure_msg.get();
+		fill_tactile_pressure(*pressure_msg, stamp, tactile_maps, calibrated);
+		g_pub_pressure.publish(pressure_msg);
+	}
+	WSG50_TRACE1(publish_done, TRACE_LOOP_TIMER);
+
+	publish_link_stats();
+
+	if (g_adaptive_rate)
+		adapt_rate(t_exchange, StateCache::now() - t_cycle);
+
+	// printf("Timer, last duration: %6.1f\n", ev.profile.last_duration.toSec() * 1000.0);
+
+}
+
+
+/**
+ * \brief Script mode: the script response carries no system state, it is queried here at a
+ * low rate. Own timer, so the round trip is not part of a control cycle and its duration.
+ */
+void state_cb(const ros::TimerEvent& ev)
+{
+	unsigned int flags;
+	if (g_mode_script && systemStateFlags(&flags) == 0)
+		update_state_flags(flags);
+}
+
+
+/** \brief Reads gripper responses in auto_update mode. The gripper pushes state messages in regular intervals. */
+void read_thread(int interval_ms)
+{
+    ROS_INFO("Thread started");
+
+    status_t status;
+    int res;
+    bool pub_state = false;
+
+    double rate_exp = 1000.0 / (double)interval_ms;
+    std::string names[3] = { "opening", "speed", "force" };
+
+    // Prepare messages
+    sun_wsg50_common::Status status_msg;
+    status_msg.status = "UNKNOWN";
+    sun_wsg50_common::StatusCompact compact_msg;
+
+    sensor_msgs::JointState joint_states;
+    joint_states.header.frame_id = "wsg_50_gripper_base_link";
+    joint_states.name.push_back("wsg_50_gripper_base_joint_gripper_left");
+    joint_states.name.push_back("wsg_50_gripper_base_joint_gripper_right");
+    joint_states.position.resize(2);
+    joint_states.velocity.resize(2);
+    joint_states.effort.resize(2);
+
+    // Request automatic updates (error checking is done below)
+    getOpening(interval_ms);
+    getSpeed(interval_ms);
+    getForce(interval_ms);
+    // System state: sent by the gripper only when it changes
+    unsigned int flags;
+    if (systemStateFlags(&flags, interval_ms) == 0) {
+        update_state_flags(flags);
+        status_msg.status = g_state_text;
+    }
+
+    // From now on this thread reads all responses, cmd_submit() waits for them
+    bool dispatching = g_mode_streaming;
+    if (dispatching)
+        dispatch_enable(g_response_timeout);
+
+    msg_t msg; msg.id = 0; msg.data = 0; msg.len = 0;
+    int cnt[3] = {0,0,0};
+    bool speed_known = false;
+    auto time_start = std::chrono::system_clock::now();
+
+
+    while (g_mode_periodic) {
+        // Receive gripper response
+        msg_free(&msg);
+        res = msg_receive( &msg );
+        if (res < 0 || msg.len < 2) {
+            ROS_ERROR("Gripper response failure: too short");
+            continue;
+        }
+
+        // Response to a command submitted by a service
+        if (dispatching && dispatch_deliver(&msg))
+            continue;
+
+        float val = 0.0;
+        status = cmd_get_response_status(msg.data);
+
+        // Decode float for opening/speed/force
+        if (msg.id >= 0x43 && msg.id <= 0x45 && msg.len == 6) {
+            if (status != E_SUCCESS) {
+                ROS_ERROR("Gripper response failure for opening/speed/force\n");
+                continue;
+            }
+            val = convert(&msg.data[2]);
+            double sent, received;
+            msg_get_times(&sent, &received);
+            state_cache().update((cache_field_t)(msg.id - 0x43), val, timestamp_model().pushed(received));
+        }
+
+        // Handle response types
+        int motion = -1;  
+        switch (msg.id) {
+        /*** Opening ***/
+        case 0x43:
+            status_msg.width = val;
+            pub_state = true;
+            cnt[0]++;
+            break;
+
+        /*** Speed ***/
+        case 0x44:
+            status_msg.speed = val;
+            speed_known = true;
+            cnt[1]++;
+            break;
+
+        /*** Force ***/
+        case 0x45:
+            status_msg.force = val;
+            cnt[2]++;
+            break;
+
+        /*** Move ***/
+        // Move commands are sent from outside this thread
+        case 0x21:
+            if (status == E_SUCCESS) {
+                ROS_INFO("Position reached");
+                motion = 0;
+            } else if (status == E_AXIS_BLOCKED) {
+                ROS_INFO("Axis blocked");
+                motion = 0;
+            } else if (status == E_CMD_PENDING) {
+                ROS_INFO("Movement started");
+                motion = 1;
+            } else if (status == E_ALREADY_RUNNING) {
+                ROS_INFO("Movement error: already running");
+            } else if (status == E_CMD_ABORTED) {
+                ROS_INFO("Movement aborted");
+                motion = 0;
+            } else {
+                ROS_INFO("Movement error");
+                motion = 0;
+            }
+            break;
+
+        /*** Stop ***/
+        // Stop commands are sent from outside this thread
+        case 0x22:
+            // Stop command; nothing to do
+            break;
+
+        /*** System state ***/
+        case 0x40:
+            if (status == E_SUCCESS && msg.len == 6) {
+                update_state_flags(stateFlags(msg.data));
+                status_msg.status = g_state_text;
+            }
+            break;
+        default:
+            ROS_INFO("Received unknown respone 0x%02x (%2dB)\n", msg.id, msg.len);
+        }
+
+        // Responses to commands sent from outside this thread
+        if (msg.id < 0x40 || msg.id > 0x45)
+            record_command(msg.id, NULL, 0, msg.len, msg.data);
+
+        // ***** PUBLISH motion message
+        WSG50_TRACE1(publish_start, TRACE_LOOP_READ_THREAD);
+        if (motion == 0 || motion == 1) {
+            std_msgs::Bool moving_msg;
+            moving_msg.data = motion;
+            g_pub_moving.publish(moving_msg);
+            g_ismoving = motion;
+        }
+
+        // ***** PUBLISH state message & joint message
+        if (pub_state) {
+            pub_state = false;
+            ros::Time stamp = sample_stamp(CACHE_OPENING);
+            gripper_response info;
+            memset(&info, 0, sizeof(info));
+            info.position = status_msg.width;
+            info.speed = status_msg.speed;
+            info.f_motor = status_msg.force;
+            record_sample(stamp, info);
+            if (g_estimator_enabled)
+                g_estimator.update(stamp.toSec(), info.position, info.speed, speed_known);
+            double t_publish = StateCache::now();
+            if (g_pub_state.getNumSubscribers() > 0 &&
+                g_filter_status.update(t_publish, status_msg.width, status_msg.force, g_state_flags)) {
+                status_msg.header.stamp = stamp;
+                g_pub_state.publish(status_msg);
+            }
+
+            if (g_pub_state_compact.getNumSubscribers() > 0 &&
+                g_filter_compact.update(t_publish, status_msg.width, status_msg.force, g_state_flags)) {
+                compact_msg.header.stamp = stamp;
+                compact_msg.state = g_state_flags;
+                compact_msg.width = status_msg.width;
+                compact_msg.speed = status_msg.speed;
+                compact_msg.force = status_msg.force;
+                g_pub_state_compact.publish(compact_msg);
+            }
+
+            if (g_pub_joint.getNumSubscribers() > 0 &&
+                g_filter_joint.update(t_publish, status_msg.width, status_msg.force)) {
+                joint_states.header.stamp = stamp;
+                joint_states.position[0] = -status_msg.width/2000.0;
+                joint_states.position[1] = status_msg.width/2000.0;
+                joint_states.velocity[0] = status_msg.speed/1000.0;
+                joint_states.velocity[1] = status_msg.speed/1000.0;
+                joint_states.effort[0] = status_msg.force;
+                joint_states.effort[1] = status_msg.force;
+                g_pub_joint.publish(joint_states);
+            }
+        }
+        WSG50_TRACE1(publish_done, TRACE_LOOP_READ_THREAD);
+        publish_link_stats();
+
+        // Check # of received messages regularly
+        std::chrono::duration<float> t = std::chrono::system_clock::now() - time_start;
+        double t_ = t.count();
+        if (t_ > 5.0) {
+            time_start = std::chrono::system_clock::now();
+            //printf("Infos for %5.1fHz, %5.1fHz, %5.1fHz\n", (double)cnt[0]/t_, (double)cnt[1]/t_, (double)cnt[2]/t_);
+
+            std::string info = "Rates for ";
+            for (int i=0; i<3; i++) {
+                double rate_is = (double)cnt[i]/t_;
+                info += names[i] + ": " + std::to_string((int)rate_is) + "Hz, ";
+                if (rate_is == 0.0)
+                    ROS_ERROR("Did not receive data for %s", names[i].c_str());
+            }
+            ROS_DEBUG_STREAM((info + " expected: " + std::to_string((int)rate_exp) + "Hz").c_str());
+            cnt[0] = 0; cnt[1] = 0; cnt[2] = 0;
+        }
+
+
+    }
+
+    if (dispatching)
+        dispatch_disable();
+
+    // Disable automatic updates
+    // TODO: The functions will receive an unexpected response
+    getOpening(0);
+    getSpeed(0);
+    getForce(0);
+    systemStateFlags(&flags, 0);
+
+    ROS_INFO("Thread ended");
+}
+
+bool driver_concurrent(ros::NodeHandle &nh)
+{
+   std::string com_mode;
+   nh.param("com_mode", com_mode, std::string(""));
+   return com_mode == "streaming";
+}
+
+/**
+ * Read the parameters, connect, advertise and start the timers/thread.
+ * Used by the wsg_50_ip_sun node and the driver nodelet.
+ */
+
+bool driver_start(ros::NodeHandle &nh, ros::NodeHandle &nh_public)
+{
+   std::string ip, protocol, com_mode;
+   int port, local_port;
+   double rate, grasping_force;
+   bool use_udp = false;
+
+   nh.param("ip", ip, std::string("192.168.1.20"));
+   nh.param("port", port, 1000);
+   nh.param("joint_prefix", joint_prefix, std::string(""));
+   nh.param("local_port", local_port, 1501);
+   nh.param("protocol", protocol, std::string(""));
+   nh.param("com_mode", com_mode, std::string(""));
+   nh.param("rate", rate, 1.0); // With custom script, up to 30Hz are possible
+   nh.param("grasping_force", grasping_force, 0.0);
+   nh.param("cache_max_age", g_cache_max_age, 0.05);
+   nh.param("response_timeout", g_response_timeout, 30.0);
+   nh.param("state_period", g_state_period, 1.0);
+   g_state_known = false;
+   load_publish_filter(nh, "status", g_filter_status);
+   load_publish_filter(nh, "status_compact", g_filter_compact);
+   load_publish_filter(nh, "width", g_filter_width);
+   load_publish_filter(nh, "joint_states", g_filter_joint);
+   std::string sample_log_path;
+   int sample_log_records;
+   nh.param("sample_log/path", sample_log_path, std::string(""));
+   nh.param("sample_log/records", sample_log_records, 262144);
+   double recorder_duration, recorder_post_trigger, recorder_holdoff;
+   int recorder_samples, recorder_commands;
+   nh.param("flight_recorder/enable", g_recorder_enabled, false);
+   nh.param("flight_recorder/duration", recorder_duration, 10.0);
+   nh.param("flight_recorder/samples", recorder_samples, 0);
+   nh.param("flight_recorder/commands", recorder_commands, 4096);
+   nh.param("flight_recorder/post_trigger", recorder_post_trigger, 0.5);
+   nh.param("flight_recorder/holdoff", recorder_holdoff, 5.0);
+   nh.param("flight_recorder/auto_dump", g_recorder_auto, false);
+   const char *ros_home = getenv("ROS_HOME"), *home = getenv("HOME");
+   nh.param("flight_recorder/directory", g_recorder_dir,
+            ros_home ? std::string(ros_home) : std::string(home ? home : ".") + "/.ros");
+   double min_rate, max_rate, rate_margin, rate_hysteresis;
+   std::string stamp_mode;
+   nh.param("stamp_mode", stamp_mode, std::string("midpoint"));
+   nh.param("adaptive_rate", g_adaptive_rate, false);
+   nh.param("min_rate", min_rate, 1.0);
+   nh.param("max_rate", max_rate, 500.0);
+   nh.param("rate_margin", rate_margin, 0.2);
+   nh.param("rate_hysteresis", rate_hysteresis, 0.1);
+   string goal_speed_topic_str("");
+   nh.param("goal_speed_topic", goal_speed_topic_str, string("goal_speed"));
+   string status_topic_str("");
+   nh.param("status_topic", status_topic_str, string("status"));
+   string homing_srv_str("");
+   nh.param("homing_srv", homing_srv_str, string("homing"));
+   string finger_distance_topic_str("");
+   nh.param("width_topic", finger_distance_topic_str, string("width"));
+   string joint_states_topic_str("");
+   nh.param("joint_states_topic", joint_states_topic_str, string("joint_states"));
+   auto joint_init = [](sensor_msgs::JointState &msg) { init_joint_state(msg, joint_prefix); };
+   g_joint_msg.set_init(joint_init);
+   g_joint_est_msg.set_init(joint_init);
+   g_tactile_msg.set_init(init_tactile);
+   g_pressure_msg.set_init(init_tactile_pressure);
+   double estimator_rate;
+   string joint_states_est_topic_str("");
+   state_estimator_params estimator_params = g_estimator.params();
+   nh.param("estimator/enable", g_estimator_enabled, false);
+   nh.param("estimator/rate", estimator_rate, 500.0);
+   nh.param("estimator/joint_states_topic", joint_states_est_topic_str, joint_states_topic_str + "_estimated");
+   nh.param("estimator/accel_noise", estimator_params.accel_noise, estimator_params.accel_noise);
+   nh.param("estimator/position_noise", estimator_params.position_noise, estimator_params.position_noise);
+   nh.param("estimator/speed_noise", estimator_params.speed_noise, estimator_params.speed_noise);
+   nh.param("estimator/command_tau", estimator_params.command_tau, estimator_params.command_tau);
+   nh.param("estimator/command_timeout", estimator_params.command_timeout, estimator_params.command_timeout);
+   nh.param("estimator/max_prediction", estimator_params.max_prediction, estimator_params.max_prediction);
+   g_estimator.set_params(estimator_params);
+   string contact_action_str;
+   contact_params contact = g_contact.params();
+   nh.param("contact/enable", g_contact_enabled, false);
+   nh.param("contact/action", contact_action_str, string("stop"));
+   nh.param("contact/min_speed", contact.min_speed, contact.min_speed);
+   nh.param("contact/arm_time", contact.arm_time, contact.arm_time);
+   nh.param("contact/speed_ratio", contact.speed_ratio, contact.speed_ratio);
+   nh.param("contact/collapse_time", contact.collapse_time, contact.collapse_time);
+   nh.param("contact/force_threshold", contact.force_threshold, contact.force_threshold);
+   nh.param("contact/finger_threshold", contact.finger_threshold, contact.finger_threshold);
+   nh.param("contact/closing_only", contact.closing_only, contact.closing_only);
+   g_contact.set_params(contact);
+   if (contact_action_str == "none")
+       g_contact_action = CONTACT_ACTION_NONE;
+   else if (contact_action_str == "force_control")
+       g_contact_action = CONTACT_ACTION_FORCE;
+   else
+       g_contact_action = CONTACT_ACTION_STOP;
+   g_speed_command = 0.0;
+   g_contact_latched = 0.0;
+   g_estimator.reset();
+   string tactile_calibration_str("");
+   nh.param("tactile/calibration", tactile_calibration_str, string(""));
+   nh.param("tactile/force_measure", g_tactile_force, false);
+   double feedback_rate;
+   nh.param("action_feedback_rate", feedback_rate, 20.0);
+   g_feedback_period = 1.0 / feedback_rate;
+   force_loop_params force_params = g_force_loop.params();
+   string force_measure_topic_str(""), force_command_topic_str(""), force_running_srv_str("");
+   nh.param("force_control/enable", g_force_control, false);
+   bool start_running;
+   nh.param("force_control/start_running", start_running, false);
+   g_force_running = start_running;
+   nh.param("force_control/measure_topic", force_measure_topic_str, string("grasp_force"));
+   nh.param("force_control/command_topic", force_command_topic_str, string("command_force"));
+   nh.param("force_control/set_running_service", force_running_srv_str, string("force_control/set_running"));
+   nh.param("force_control/timeout", g_force_timeout, 0.1);
+   nh.param("force_control/control_gain", force_params.control_gain, force_params.control_gain);
+   nh.param("force_control/max_force", force_params.max_force, force_params.max_force);
+   nh.param("force_control/stiff_1", force_params.stiff_1, force_params.stiff_1);
+   nh.param("force_control/stiff_2", force_params.stiff_2, force_params.stiff_2);
+   nh.param("force_control/use_linear_model", force_params.linear_model, force_params.linear_model);
+   nh.param("force_control/cut_freq", force_params.cut_freq, force_params.cut_freq);
+   nh.param("force_control/width_min", force_params.width_min, force_params.width_min);
+   nh.param("force_control/width_max", force_params.width_max, force_params.width_max);
+   g_force_loop.set_params(force_params);
+
+   if (protocol == "udp")
+       use_udp = true;
+   else
+       protocol = "tcp";
+   if (com_mode == "script")
+       g_mode_script = true;
+   else if (com_mode == "auto_update")
+       g_mode_periodic = true;
+   else if (com_mode == "streaming") {
+       g_mode_periodic = true;
+       g_mode_streaming = true;
+   }
+   else {
+       com_mode = "polling";
+       g_mode_polling = true;
+   }
+
+   if (g_force_control && !g_mode_script) {
+       ROS_WARN("force_control needs com_mode script, disabled");
+       g_force_control = false;
+   }
+
+   if (!tactile_calibration_str.empty() && g_mode_script) {
+       string error;
+       if (g_tactile_cal.load(tactile_calibration_str.c_str(), &error) == 0)
+           ROS_INFO("Tactile calibration loaded from %s", tactile_calibration_str.c_str());
+       else
+           ROS_ERROR("Tactile calibration: %s, publishing raw voltages only", error.c_str());
+   }
+   if (g_tactile_force && !g_tactile_cal.loaded()) {
+       ROS_WARN("tactile/force_measure needs a tactile/calibration, disabled");
+       g_tactile_force = false;
+   }
+
+   if (stamp_mode == "receive")
+       timestamp_model().set_mode(STAMP_RECEIVE);
+   else if (stamp_mode == "learned")
+       timestamp_model().set_mode(STAMP_LEARNED);
+   else {
+       stamp_mode = "midpoint";
+       timestamp_model().set_mode(STAMP_MIDPOINT);
+   }
+
+   ROS_INFO("Connecting to %s:%d (%s); communication mode: %s ...", ip.c_str(), port, protocol.c_str(), com_mode.c_str());
+
+   // Connect to device using TCP/USP
+   int res_con;
+   if (!use_udp)
+       res_con = cmd_connect_tcp( ip.c_str(), port );
+   else
+       res_con = cmd_connect_udp(local_port, ip.c_str(), port );
+
+   if (res_con == 0 ) {
+        ROS_INFO("Gripper connection stablished");
+
+        // The dispatcher of the streaming mode lets commands run concurrently
+        ros::NodeHandle nh_control(nh_public);
+        if (g_mode_streaming)
+            nh_control.setCallbackQueue(&g_control_queue);
+
+		// Services
+        if (g_mode_script || g_mode_polling || g_mode_streaming) {
+            g_services.push_back(nh_public.advertiseService("move", moveSrv));
+            g_services.push_back(nh_public.advertiseService("grasp", graspSrv));
+            g_services.push_back(nh_public.advertiseService("release", releaseSrv));
+            g_services.push_back(nh_public.advertiseService(homing_srv_str, homingSrv));
+            g_services.push_back(nh_control.advertiseService("stop", stopSrv));
+            g_services.push_back(nh_control.advertiseService("ack", ackSrv));
+            g_services.push_back(nh_public.advertiseService("move_incrementally", incrementSrv));
+
+            g_services.push_back(nh_public.advertiseService("set_acceleration", setAccSrv));
+            g_services.push_back(nh_public.advertiseService("set_force", setForceSrv));
+            g_services.push_back(nh_public.advertiseService("get_state", getStateSrv));
+            // Non-blocking motions need the reader thread of the streaming mode
+            if (g_mode_streaming) {
+                ros::NodeHandle nh_action(nh_public);
+                nh_action.setCallbackQueue(&g_action_queue);
+                g_move_action.reset(new MoveActionServer(nh_action, "action/move", moveActionCb, false));
+                g_grasp_action.reset(new MoveActionServer(nh_action, "action/grasp", graspActionCb, false));
+                g_release_action.reset(new MoveActionServer(nh_action, "action/release", releaseActionCb, false));
+                g_homing_action.reset(new HomingActionServer(nh_action, "action/homing", homingActionCb, false));
+                g_move_action->start();
+                g_grasp_action->start();
+                g_release_action->start();
+                g_homing_action->start();
+                g_action_spinner.reset(new ros::AsyncSpinner(1, &g_action_queue));
+                g_action_spinner->start();
+            }
+        }
+
+		// Subscriber
+        if (g_mode_script || g_mode_periodic)
+            g_sub_position = nh_control.subscribe("goal_position", 5, position_cb);
+        if (g_mode_script)
+            g_sub_speed = nh_public.subscribe(goal_speed_topic_str, 1, speed_cb);
+        if (g_force_control) {
+            if (g_tactile_force)
+                ROS_INFO("Force control: measure from the calibrated finger sensors, %s not subscribed",
+                         force_measure_topic_str.c_str());
+            else
+                g_sub_force = nh_public.subscribe(force_measure_topic_str, 1, force_measure_cb, ros::TransportHints().tcpNoDelay());
+            g_sub_force_cmd = nh_public.subscribe(force_command_topic_str, 1, force_command_cb);
+            g_services.push_back(nh_public.advertiseService(force_running_srv_str, forceRunningSrv));
+            g_pub_force_latency = nh_public.advertise<sun_ros_msgs::Float64Stamped>("force_control/latency", 1);
+        }
+
+		// Publisher
+		g_pub_state = nh_public.advertise<sun_wsg50_common::Status>(status_topic_str, 1);
+		g_pub_state_compact = nh_public.advertise<sun_wsg50_common::StatusCompact>(status_topic_str + "_compact", 1);
+		g_pub_state_text = nh_public.advertise<std_msgs::String>(status_topic_str + "_text", 1, true);
+		g_pub_joint = nh_public.advertise<sensor_msgs::JointState>(joint_states_topic_str, 10);
+        g_pub_distnce = nh_public.advertise<sun_ros_msgs::Float64Stamped>(finger_distance_topic_str, 1);
+        if (g_mode_script || g_mode_periodic) {
+            g_pub_moving = nh_public.advertise<std_msgs::Bool>("moving", 10);
+            g_pub_command_stats = nh_public.advertise<sun_wsg50_common::CommandStats>("command_stats", 1);
+        }
+        g_pub_exchange = nh_public.advertise<sun_wsg50_common::ExchangeStats>("exchange_stats", 1);
+        if (g_mode_script) {
+            g_pub_clock = nh_public.advertise<sun_wsg50_common::ClockStats>("clock_stats", 1);
+            g_pub_tactile = nh_public.advertise<sun_wsg50_common::Tactile>("tactile", 1);
+            if (g_tactile_cal.loaded())
+                g_pub_pressure = nh_public.advertise<sun_wsg50_common::TactilePressure>("tactile_pressure", 1);
+        }
+        if (g_mode_script && g_contact_enabled) {
+            g_pub_contact = nh_public.advertise<sun_wsg50_common::ContactEvent>("contact", 10);
+            if (g_contact_action == CONTACT_ACTION_FORCE && !g_force_control)
+                ROS_WARN("contact/action force_control needs force_control/enable, stopping on contact");
+        }
+
+		ROS_INFO("Ready to use, homing now...");
+		homing();
+
+		if (grasping_force > 0.0) {
+			ROS_INFO("Setting grasping force limit to %5.1f", grasping_force);
+			setGraspingForceLimit(grasping_force);
+		}
+
+        if (!sample_log_path.empty()) {
+            if (g_sample_log.open(sample_log_path.c_str(), sample_log_records > 0 ? sample_log_records : 1,
+                                  ros::Time::now().toSec()) == 0)
+                ROS_INFO("Logging samples to %s (%d records)", sample_log_path.c_str(), sample_log_records);
+            else
+                ROS_ERROR("Unable to create the sample log %s: %s", sample_log_path.c_str(), strerror(errno));
+        }
+
+        if (g_recorder_enabled) {
+            // Default ring: the duration at the highest loop rate, with a margin
+            if (recorder_samples <= 0)
+                recorder_samples = (int)(recorder_duration * (g_adaptive_rate ? max_rate : rate) * 1.2) + 16;
+            g_recorder.configure(recorder_duration, recorder_samples, std::max(recorder_commands, 1),
+                                 recorder_post_trigger, recorder_holdoff);
+            g_crc_errors = msg_checksum_errors();
+            cmd_set_observer(record_command);
+            g_services.push_back(nh_public.advertiseService("flight_recorder/dump", dumpRecorderSrv));
+            ROS_INFO("Flight recorder: last %.1f s (%d samples, %d commands)%s", recorder_duration,
+                     recorder_samples, recorder_commands, g_recorder_auto ? ", dumped on faults" : "");
+        }
+
+        ROS_INFO("Init done. Starting timer/thread with target rate %.1f.", rate);
+        if (g_mode_polling || g_mode_script) {
+            if (g_adaptive_rate) {
+                // Start at the configured rate, then follow the measured round trip time
+                g_rate_ctrl = RateController(rate, min_rate, max_rate, rate_margin, rate_hysteresis);
+                g_pub_rate = nh_public.advertise<std_msgs::Float64>("loop_rate", 1, true);
+                g_pub_overruns = nh_public.advertise<std_msgs::UInt32>("loop_overruns", 1, true);
+            }
+            g_loop_timer = nh.createTimer(ros::Duration(1.0/rate), timer_cb);
+        }
+        if (g_mode_script && g_state_period > 0.0)
+            g_state_timer = nh.createTimer(ros::Duration(g_state_period), state_cb);
+        if (g_mode_periodic) {
+             g_read_thread = std::thread(read_thread, (int)(1000.0/rate));
+             g_command_timer = nh_control.createTimer(ros::Duration(1.0/rate), command_cb);
+        }
+        if (g_mode_streaming) {
+            g_control_spinner.reset(new ros::AsyncSpinner(1, &g_control_queue));
+            g_control_spinner->start();
+        }
+        if (g_estimator_enabled && estimator_rate > 0.0) {
+            g_pub_joint_est = nh_public.advertise<sensor_msgs::JointState>(joint_states_est_topic_str, 10);
+            g_pub_estimate = nh_public.advertise<sun_wsg50_common::StateEstimate>("state_estimate", 10);
+            g_estimator_running = true;
+            g_estimator_thread = std::thread(estimator_thread, estimator_rate);
+            ROS_INFO("Publishing estimated joint states at %.1f Hz", estimator_rate);
+        }
+
+        return true;
+	}
+
+    ROS_ERROR("Unable to connect, please check the port and address used.");
+    return false;
+}
+
+/**
+ * Stop the timers and the read thread, disconnect
+ */
+
+void driver_stop()
+{
+    ROS_INFO("Exiting...");
+    g_loop_timer.stop();
+    g_state_timer.stop();
+    g_command_timer.stop();
+    g_services.clear();
+    g_sub_position.shutdown();
+    g_sub_speed.shutdown();
+    g_sub_force.shutdown();
+    g_sub_force_cmd.shutdown();
+    if (g_control_spinner) {
+        g_control_spinner->stop();
+        g_control_spinner.reset();
+    }
+    g_control_queue.clear();
+
+    // read_thread() has to give the interface back before disconnecting
+    g_mode_periodic = false;
+    g_mode_script = false;
+    g_mode_polling = false;
+    g_mode_streaming = false;
+    if (g_read_thread.joinable())
+        g_read_thread.join();
+    g_estimator_running = false;
+    if (g_estimator_thread.joinable())
+        g_estimator_thread.join();
+
+    // Running goals were stopped, their commands failed with the reader thread
+    if (g_action_spinner) {
+        g_action_spinner->stop();
+        g_action_spinner.reset();
+    }
+    g_move_action.reset();
+    g_grasp_action.reset();
+    g_release_action.reset();
+    g_homing_action.reset();
+    g_action_queue.clear();
+
+    log_command_stats(false);
+    ROS_DEBUG("Messages allocated: status %lu, status_compact %lu, width %lu, joint_states %lu",
+              g_status_msg.allocations(), g_compact_msg.allocations(), g_width_msg.allocations(),
+              g_joint_msg.allocations());
+    ROS_DEBUG("Cycles not published: status %lu, status_compact %lu, width %lu, joint_states %lu",
+              g_filter_status.skipped(), g_filter_compact.skipped(), g_filter_width.skipped(),
+              g_filter_joint.skipped());
+
+    cmd_set_observer(NULL);
+    if (g_recorder_dump.valid())
+        g_recorder_dump.wait();
+
+    // Timers and spinners stopped, threads joined: nothing writes the log any more
+    if (g_sample_log.is_open()) {
+        ROS_INFO("Samples logged: %lu", (unsigned long)g_sample_log.count());
+        g_sample_log.close();
+    }
+    cmd_disconnect();
+}
+
+
+//------------------------------------------------------------------------
+// Testing functions
+//------------------------------------------------------------------------
@@ -59,6 +59,10 @@
 #include "wsg_50/cmd.h"
 #include "wsg_50/msg.h"
 #include "wsg_50/functions.h"
+#include "wsg_50/state_cache.h"
+#include "wsg_50/timestamp.h"
+#include "wsg_50/clock_sync.h"
+#include "wsg_50/tactile.h"
 
 //------------------------------------------------------------------------
 // Support functions
@@ -84,6 +88,20 @@ float convert(unsigned char *b){
 }
 
 
+// Status of the last actuation command of each thread, see command_status()
+static thread_local status_t last_status = E_SUCCESS;
+
+
+/** \brief Estimated sampling instant of the exchange that just completed (see timestamp.h) */
+static double exchange_sample_time()
+{
+	double sent, received;
+
+	msg_get_times(&sent, &received);
+	return timestamp_model().exchange(sent, received);
+}
+
+
 //------------------------------------------------------------------------
 // Function implementation
 //------------------------------------------------------------------------
@@ -114,6 +132,7 @@ int homing( void )
 	{
 		dbgPrint( "Response payload length doesn't match (is %d, expected 2)\n", res );
 		if ( res > 0 ) free( resp );
+		last_status = E_CMD_FAILED;
 		return 0;
 	}
 
@@ -122,6 +141,7 @@ int homing( void )
 
 	// Check response status
 	status = cmd_get_response_status( resp );
+	last_status = status;
 	free( resp );
 	if ( status != E_SUCCESS )
 	{
@@ -160,11 +180,13 @@ int move( float width, float speed, bool stop_on_block, bool ignore_response)
         {
             dbgPrint( "Response payload length doesn't match (is %d, expected 2)\n", res );
             if ( res > 0 ) free( resp );
+            last_status = E_CMD_FAILED;
             return 0;
         }
 
         // Check response status
         status = cmd_get_response_status( resp );
+        last_status = status;
         free( resp );
         if ( status != E_SUCCESS )
         {
@@ -173,9 +195,7 @@ int move( float width, float speed, bool stop_on_block, bool ignore_response)
         }
     } else {
         // Submit command, do not wait for response
-        msg_t msg;
-        msg.id = 0x21; msg.len = 9; msg.data = &payload[0];
-        res = msg_send(&msg);
+        res = cmd_send(0x21, payload, 9, true);
         if (res <= 0) {
             dbgPrint("Failed to send command MOVE\n");
             return -1;
@@ -216,9 +236,7 @@ int stop( bool ignore_response )
         }
     } else {
         // Submit command, do not wait for response
-        msg_t msg;
-        msg.id = 0x22; msg.len = 0; msg.data = &payload[0];
-        res = msg_send(&msg);
+        res = cmd_send(0x22, payload, 0, true);
         if (res <= 0) {
             dbgPrint("Failed to send command STOP\n");
             return -1;
@@ -282,11 +300,13 @@ int grasp( float objWidth, float speed )
 	{
 		dbgPrint( "Response payload length doesn't match (is %d, expected 2)\n", res );
 		if ( res > 0 ) free( resp );
+		last_status = E_CMD_FAILED;
 		return 0;
 	}
 
 	// Check response status
 	status = cmd_get_response_status( resp );
+	last_status = status;
 	free( resp );
 	if ( status != E_SUCCESS )
 	{
@@ -316,11 +336,13 @@ int release( float width, float speed )
 	{
 		dbgPrint( "Response payload length doesn't match (is %d, expected 2)\n", res );
 		if ( res > 0 ) free( resp );
+		last_status = E_CMD_FAILED;
 		return -1;
 	}
 
 	// Check response status
 	status = cmd_get_response_status( resp );
+	last_status = status;
 	free( resp );
 	if ( status != E_SUCCESS )
 	{
@@ -366,6 +388,9 @@ int script_measure_move (unsigned char cmd_type, float cmd_width, float cmd_spee
 			throw std::string("Command failed");
 		//if (res != 23)
 		//	throw std::string("Response payload incorrect (" + std::to_string(res) + ")");
+		// Every measure script answers status, position, speed, motor force, [finger blocks], [seq, tick]
+		if (res < 14)
+			throw std::string("Response payload incorrect (" + std::to_string(res) + " bytes)");
 		//printf("SCRIPT_MEASURE - try01\n");
 		// Extract data from response
 		int off=2;
@@ -380,49 +405,57 @@ int script_measure_move (unsigned char cmd_type, float cmd_width, float cmd_spee
 		info.position = convert(&resp[off]);     off+=4;
 //printf("SCRIPT_MEASURE - try01\n");
 		info.speed = convert(&resp[off]);        off+=4;
-		info.f_motor = 0.0;//convert(&resp[off]);      off+=4;
-//printf("SCRIPT_MEASURE - try01\n");
-
-	info.f_finger0 = 100;// Finger 0 NO FMF
-	//for(int i = 0; i < 25 ; i++)
-	//				info.v_finger0[i] = (float)( resp[off+i*2] + resp[off+(i*2+1)] * 255 ) *3.3/4096.0;
-	info.tact_finger0 = false;
-
-	info.f_finger1 = 100; // Finger 1 NO FMF
-	info.tact_finger1 = false;
-
-// LETTURA FING
-/*
-		int finger_head = (int)resp[off]; off++;
-		if(finger_head == 2){ //FMF
-			info.f_finger0 = convert(&resp[off]);    off+=4;
-			info.tact_finger0 = false;
-		} else {
-			info.f_finger0 = 100; // Finger 0 NO FMF
-			if(finger_head == 1){ //generic
-				for(int i = 0; i < 25 ; i++)
-					info.v_finger0[i] = (float)( resp[off+i*2] + resp[off+(i*2+1)] * 255 ) *3.3/4096.0;
-				off+=50;
-				info.tact_finger0 = true;  
-			} else info.tact_finger0 = false;
 
+		info.f_motor = convert(&resp[off]);      off+=4;
+		info.f_finger0 = 100;	// No FMF
+		info.f_finger1 = 100;
+		info.tact_finger0 = false;
+		info.tact_finger1 = false;
+
+		// Optional finger blocks, one per finger: head byte (FINGER_*) and its data.
+		// Present unless only the clock trailer (8 bytes) or nothing follows.
+		if (res != off && res != off + 8) {
+			float *force[2] = { &info.f_finger0, &info.f_finger1 };
+			float *volts[2] = { info.v_finger0, info.v_finger1 };
+			bool *tactile[2] = { &info.tact_finger0, &info.tact_finger1 };
+			for (int f = 0; f < 2; f++) {
+				if (off + 1 > res)
+					throw std::string("Response payload incorrect");
+				unsigned char head = resp[off++];
+				if (head == FINGER_FMF) {
+					if (off + 4 > res)
+						throw std::string("Response payload incorrect");
+					*force[f] = convert(&resp[off]);        off+=4;
+				} else if (head == FINGER_GENERIC) {
+					if (off + TACTILE_BYTES > res)
+						throw std::string("Response payload incorrect");
+					tactile_decode(&resp[off], volts[f], TACTILE_TAXELS);
+					off+=TACTILE_BYTES;
+					*tactile[f] = true;
+				} else if (head != FINGER_NONE) {
+					throw std::string("Response payload incorrect (finger " + std::to_string(head) + ")");
+				}
+			}
 		}
-		finger_head = (int)resp[off]; off++;
-		if(finger_head == 2){ //FMF
-			info.f_finger1 = convert(&resp[off]);    off+=4;
-			info.tact_finger1 = false;
-		} else {
-			info.f_finger1 = 100; // Finger 0 NO FMF
-			if(finger_head == 1){ //generic
-				for(int i = 0; i < 25 ; i++)
-					info.v_finger1[i] = (float)( resp[off+i*2] + resp[off+(i*2+1)] * 255 ) *3.3/4096.0;
-				//off+=50;
-				info.tact_finger1 = true; 
-			} else info.tact_finger1 = false;
 
+		// Only the clock trailer or nothing may follow: any other length is
+		// a script with another layout, don't read its bytes as ours
+		if (res != off && res != off + 8)
+			throw std::string("Response payload incorrect (" + std::to_string(res) + " bytes)");
+
+		// Optional trailer of the measure scripts: uint32 sequence number
+		// and uint32 device tick [ms], little endian
+		double stamp = exchange_sample_time();
+		info.has_clock = (res == off + 8);
+		if (info.has_clock) {
+			info.seq = resp[off] | (resp[off+1] << 8) | (resp[off+2] << 16) | ((unsigned int) resp[off+3] << 24);
+			off+=4;
+			info.device_ms = resp[off] | (resp[off+1] << 8) | (resp[off+2] << 16) | ((unsigned int) resp[off+3] << 24);
+			off+=4;
+			stamp = clock_sync().update(info.seq, info.device_ms, stamp);
 		}
-*/
-		
+		state_cache().update(info.position, info.speed, info.f_motor, stamp);
+
 		//printf("SCRIPT_MEASURE - try02\n");
 
 		info.ismoving = (info.state & 0x02/*fingers mnoving*/) != 0;
@@ -432,7 +465,7 @@ int script_measure_move (unsigned char cmd_type, float cmd_width, float cmd_spee
 		if (0)
 			printf("Received: %02X, %6.2f,%6.2f,%6.2f,%6.2f,%6.2f\n  %s\n",
 				info.state, info.position, info.speed, info.f_motor, info.f_finger0, info.f_finger1,
-				info.state_text.c_str());
+				info.state_text ? info.state_text : "");
 		//printf("SCRIPT_MEASURE - try-end\n");
 	} catch (std::string msg) {
 		//printf("SCRIPT_MEASURE - catch\n");
@@ -525,7 +558,13 @@ int setGraspingForceLimit( float force )
 ///////////////////
 
 
-const char * systemState( void ) 
+/** \brief Read the system state bitmask from gripper (0x40).
+ *  \param flags Receives the bitmask (D0 = LSB)
+ *  \param auto_update Request updates (unit: ms) from the gripper, sent only when the
+ *         state changes; responses need to be read out elsewhere.
+ *  \return 0 on success, -1 otherwise
+ */
+int systemStateFlags( unsigned int *flags, int auto_update )
 {
 	status_t status;
 	int res;
@@ -533,8 +572,14 @@ const char * systemState( void )
 	unsigned char *resp;
 	unsigned int resp_len;
 
-	// Don't use automatic update, so the payload bytes are 0.
+	// Payload = 0, except for auto update (periodic, only on change)
 	memset( payload, 0, 3 );
+	if ( auto_update > 0 )
+	{
+		payload[0] = 0x03;
+		payload[1] = ( auto_update & 0xff );
+		payload[2] = ( ( auto_update & 0xff00 ) >> 8 );
+	}
 
 	// Submit command and wait for response. Expecting exactly 4 bytes response payload.
 	res = cmd_submit( 0x40, payload, 3, false, &resp, &resp_len );
@@ -542,33 +587,30 @@ const char * systemState( void )
 	{
 		dbgPrint( "Response payload length doesn't match (is %d, expected 6)\n", res );
 		if ( res > 0 ) free( resp );
-		return 0;
+		return -1;
 	}
 
 	// Check response status
 	status = cmd_get_response_status( resp );
-
-	/*
-	dbgPrint("LSB -> resp[0]: %x\n", resp[2]);
-	dbgPrint("       resp[1]: %x\n", resp[3]);
-	dbgPrint("       resp[2]: %x\n", resp[4]);
-	dbgPrint("MSB -> resp[3]: %x\n", resp[5]);
-	*/
-
-	return getStateValues(resp);
-
 	if ( status != E_SUCCESS )
 	{
 		dbgPrint( "Command GET SYSTEM STATE not successful: %s\n", status_to_str( status ) );
 		free( resp );
-		return 0;
+		return -1;
 	}
 
+	*flags = stateFlags( resp );
 	free( resp );
+	return 0;
+}
 
-    return 0;
 
-	//return (int) resp[2]; MBJ
+const char * systemState( void ) 
+{
+	unsigned int flags;
+
+	if ( systemStateFlags( &flags ) != 0 ) return 0;
+	return getStateText( flags );
 }
 
 
@@ -647,6 +689,8 @@ float getOpeningSpeedForce(unsigned char cmd, int auto_update)
 
     float r = convert(&resp[2]);
     free( resp );
+    if (cmd >= 0x43 && cmd <= 0x45)
+        state_cache().update((cache_field_t)(cmd - 0x43), r, exchange_sample_time());
     return r;
 }
 
@@ -672,6 +716,56 @@ float getForce(int auto_update){
 }
 
 
+StateCache & state_cache()
+{
+    static StateCache cache;
+    return cache;
+}
+
+TimestampModel & timestamp_model()
+{
+    static TimestampModel model;
+    return model;
+}
+
+ClockSync & clock_sync()
+{
+    static ClockSync sync;
+    return sync;
+}
+
+/** \brief Status of the last homing/move/grasp/release of the calling thread
+ *         (E_CMD_FAILED if no valid response was received) */
+status_t command_status( void )
+{
+    return last_status;
+}
+
+/** \brief Opening/speed/force from the state cache if not older than max_age [s],
+ *         else read from the gripper (which refreshes the cache).
+ */
+static float getCached(cache_field_t field, unsigned char cmd, double max_age)
+{
+    float value;
+
+    if (state_cache().get(field, max_age, &value))
+        return value;
+    return getOpeningSpeedForce(cmd, 0);
+}
+
+float getOpeningCached(double max_age) {
+    return getCached(CACHE_OPENING, 0x43, max_age);
+}
+
+float getSpeedCached(double max_age) {
+    return getCached(CACHE_SPEED, 0x44, max_age);
+}
+
+float getForceCached(double max_age) {
+    return getCached(CACHE_FORCE, 0x45, max_age);
+}
+
+
 int getAcceleration( void )  
 {
 	status_t status;
@@ -1,18 +1,19 @@
 //======================================================================
 /**
  *  @file
- *  msg.c
+ *  msg.cpp
  *
- *  @section msg.c_general General file information
+ *  @section msg.cpp_general General file information
  *
  *  @brief
- *  Raw send and receive functions for command messages
+ *  Raw send and receive functions for command messages.
+ *  Thin C wrapper around Gripper<InterfaceTransport> (see gripper.h).
  *
  *  @author wolfer
  *  @date	07.07.2011
  *  
  *  
- *  @section msg.c_copyright Copyright
+ *  @section msg.cpp_copyright Copyright
  *  
  *  Copyright 2011 Weiss Robotics, D-71636 Ludwigsburg, Germany
  *  
@@ -53,9 +54,9 @@
 #include <string.h>
 
 #include "wsg_50/common.h"
-#include "wsg_50/checksum.h"
 #include "wsg_50/interface.h"
 #include "wsg_50/msg.h"
+#include "wsg_50/gripper.h"
 
 
 //------------------------------------------------------------------------
@@ -72,7 +73,7 @@
 // Global variables
 //------------------------------------------------------------------------
 
-static const interface_t *interface;
+static Gripper<InterfaceTransport> gripper;
 
 
 //------------------------------------------------------------------------
@@ -92,8 +93,8 @@ static const interface_t *interface;
 /**
  * Receive answer
  *
- * @param **response		Data buffer
- * @param len				Expected size of message
+ * @param *msg		Message struct. The payload is allocated and
+ * 					has to be released with msg_free().
  *
  * @return Overall number of bytes received, including header and checksum. -1 on error.
  */
@@ -101,146 +102,70 @@ static const interface_t *interface;
 int msg_receive( msg_t *msg )
 {
 	int res;
-	unsigned char header[3];			// 1 byte command, 2 bytes payload length
-	unsigned short checksum = 0x50f5;	// Checksum over preamble (0xaa 0xaa 0xaa)
-	unsigned int sync;
-
-	// Syncing - necessary for compatibility with serial interface
-	sync = 0;
-	//printf("MSG_RECEIVE-prima while\n");
-	while( sync != MSG_PREAMBLE_LEN )
-	{	
-		//printf("MSG_RECEIVE- while sync=%d\n",sync);
-		res = interface->read( header, 1 );
-		if ( header[0] == MSG_PREAMBLE_BYTE ) sync++;
-	}
-	//printf("MSG_RECEIVE-dopo while\n");
-
-	// Read header
-	res = interface->read( header, 3 );
-	if ( res < 3 )
-	{
-		fprintf( stderr, "Failed to receive header data (%d bytes read)\n", res );
-		return -1;
-	}
+	msg_t frame;
 
-	// Calculate checksum over header
-	checksum = checksum_update_crc16( header, 3, checksum );
+	res = gripper.receive( &frame );
+	if ( res < 0 ) return -1;
 
-	// Get message id of received
-	msg->id = header[0];
-
-	// Get payload size of received message
-	msg->len = make_short( header[1], header[2] );
+	msg->id = frame.id;
+	msg->len = frame.len;
 
 	// Allocate space for payload and checksum
-	msg->data = malloc( msg->len + 2u );
+	msg->data = (unsigned char *) malloc( frame.len + 2u );
 	if ( !msg->data ) return -1;
+	memcpy( msg->data, frame.data, frame.len + 2u );
 
-	// Read payload and checksum
-	res = interface->read( msg->data, msg->len + 2 );
-	if ( res < (int) (msg->len + 2) )
-	{
-		fprintf( stderr, "Not enough data (%d, expected %d)\n", res, msg->len + 2 );
-		return -1;
-	}
-
-	// Check checksum
-	checksum = checksum_update_crc16( msg->data, msg->len + 2, checksum );
-	if ( checksum != 0 )
-	{
-		fprintf( stderr, "Checksum error\n" );
-		return -1;
-	}
-	//printf("MSG_RECEIVE-fine\n");
-	return msg->len + 8;
+	return res;
 }
 
 
 /**
  * Send command
  *
- * @param id		Command ID
- * @param len		Payload length
- * @param *payload	Payload data
+ * @param *msg		Message struct holding command ID, payload
+ * 					length and payload data
  *
- * @return 0 on success, else -1
+ * @return Number of bytes sent on success, else -1
  */
 
 int msg_send( msg_t *msg )
 {
-	unsigned char header[MSG_PREAMBLE_LEN + 3];
-    //unsigned char checksum[2];
-	unsigned short crc;
-	int i, res;
+	const interface_t *iface = gripper.transport().get();
+
+	if ( !iface || !iface->write ) return -1;
 
-	// Preamble
-	for ( i = 0; i < MSG_PREAMBLE_LEN; i++ ) header[i] = MSG_PREAMBLE_BYTE;
+	if ( gripper.send( msg->id, msg->data, msg->len ) < 0 )
+	{
+		gripper.close();
+		quit( "Failed to submit message" );
+	}
 
-	// Command ID
-	header[MSG_PREAMBLE_LEN] = msg->id;
+	return msg->len + 8;
+}
 
-	// Length
-	header[MSG_PREAMBLE_LEN + 1] = lo( msg->len );
-	header[MSG_PREAMBLE_LEN + 2] = hi( msg->len );
 
-	// Checksum
-	crc = checksum_crc16( header, 6 );
-	crc = checksum_update_crc16( msg->data, msg->len, crc );
+/**
+ * Timing of the last exchange
+ *
+ * @param *sent			Set to the monotonic time [s] the last frame was sent
+ * @param *received		Set to the monotonic time [s] the header of the last
+ * 						frame was received
+ */
 
-    //checksum[0] = lo( crc );
-    //checksum[1] = hi( crc );
+void msg_get_times( double *sent, double *received )
+{
+	*sent = gripper.sent_at();
+	*received = gripper.received_at();
+}
 
-	if ( interface->write )
-	{
 
-		unsigned char *buf = malloc( 6 + msg->len + 2 ); // 6+2 fixes (PREAMBLE, ID, PAILOAD / ... / CRC)
-		memcpy( buf, header, 6 );
-		memcpy( buf + 6, msg->data, msg->len );
-		memcpy( buf + 6 + msg->len, (unsigned char *) &crc, 2 );
-
-		res = interface->write( buf, 6 + msg->len + 2 );
-        if ( res < 6 + (int)msg->len + 2 )
-		{
-			interface->close();
-			quit( "Failed to submit message checksum" );
-		}
-
-		free( buf );
-
-// The following implementation doesn't work:
-//
-//		// Submit header
-//		res = interface->write( header, 6 );
-//		if ( res < 6 )
-//		{
-//			interface->close();
-//			quit( "Failed to submit message header" );
-//		}
-//
-//		// Submit payload
-//		res = interface->write( msg->data, msg->len );
-//		if ( res < msg->len )
-//		{
-//			interface->close();
-//			quit( "Failed to submit message payload" );
-//		}
-//
-//		res = interface->write( (unsigned char *) &crc, 2 );
-//		if ( res < sizeof( crc ) )
-//		{
-//			interface->close();
-//			quit( "Failed to submit message checksum" );
-//		}
-
-//		unsigned short check = checksum_crc16( header, 6 );
-//		check = checksum_update_crc16( msg->data, msg->len, check );
-//		check = checksum_update_crc16( (unsigned char *) &crc, sizeof( short ), check );
-
-		return msg->len + 8;
-	}
+/**
+ * Number of frames dropped because of a checksum error since start
+ */
 
-	return -1;
+unsigned long msg_checksum_errors( void )
+{
+	return gripper.crc_errors();
 }
 
 
@@ -255,11 +180,13 @@ int msg_send( msg_t *msg )
 
 int msg_change_interface( const interface_t *iface )
 {
+	const interface_t *current = gripper.transport().get();
+
 	if ( !iface ) return -1;
 
-	if ( interface && iface != interface && interface->close ) interface->close();
+	if ( current && iface != current && current->close ) current->close();
 
-	interface = iface;
+	gripper.transport().set( iface );
 
 	return 0;
 }
@@ -282,8 +209,7 @@ int msg_open( const interface_t *iface, const void *params )
 	res = msg_change_interface( iface );
 	if ( res < 0 ) return( res );
 
-	if ( iface->open ) return iface->open( params );
-	else return -1;
+	return gripper.transport().open( params );
 }
 
 
@@ -293,8 +219,7 @@ int msg_open( const interface_t *iface, const void *params )
 
 void msg_close( void )
 {
-	if ( !interface || !interface->close ) return;
-	interface->close();
+	gripper.close();
 }
 
 
@@ -307,7 +232,7 @@ void msg_close( void )
 void msg_free( msg_t *msg )
 {
 	if ( msg->data ) free( msg->data );
-	memset( msg, 0, sizeof( msg ) );
+	memset( msg, 0, sizeof( *msg ) );
 }
 
 
@@ -0,0 +1,184 @@
+//======================================================================
+/**
+ *  @file
+ *  sample_log.cpp
+ *
+ *  @section sample_log.cpp_general General file information
+ *
+ *  @brief
+ *  Binary log of every device sample in a memory-mapped ring file.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section sample_log.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+
+#include "wsg_50/sample_log.h"
+
+
+static_assert( sizeof( sample_log_header ) == 64, "sample_log_header is part of the file format" );
+static_assert( sizeof( sample_record ) == 264, "sample_record is part of the file format" );
+
+
+//------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------
+
+SampleLog::SampleLog() : header_( NULL ), records_( NULL ), size_( 0 ), count_( 0 )
+{
+}
+
+
+SampleLog::~SampleLog()
+{
+	close();
+}
+
+
+int SampleLog::open( const char *path, uint64_t capacity, double created )
+{
+	close();
+	if ( capacity == 0 )
+	{
+		errno = EINVAL;
+		return -1;
+	}
+
+	size_t size = sizeof( sample_log_header ) + capacity * sizeof( sample_record );
+	int fd = ::open( path, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+	if ( fd < 0 ) return -1;
+
+	// Allocate the blocks now: a full disk must fail here, not as SIGBUS in append()
+	int err = posix_fallocate( fd, 0, size );
+	if ( err != 0 )
+	{
+		::close( fd );
+		errno = err;
+		return -1;
+	}
+
+	// Prefaulted, so append() does not stall the I/O thread on first touch
+	void *map = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0 );
+	::close( fd );
+	if ( map == MAP_FAILED ) return -1;
+
+	header_ = (sample_log_header *) map;
+	records_ = (sample_record *) ( header_ + 1 );
+	size_ = size;
+	count_ = 0;
+
+	memset( header_, 0, sizeof( sample_log_header ) );
+	memcpy( header_->magic, SAMPLE_LOG_MAGIC, sizeof( header_->magic ) );
+	header_->version = SAMPLE_LOG_VERSION;
+	header_->record_size = sizeof( sample_record );
+	header_->capacity = capacity;
+	header_->created = created;
+	return 0;
+}
+
+
+void SampleLog::close()
+{
+	if ( !header_ ) return;
+	msync( header_, size_, MS_SYNC );
+	munmap( header_, size_ );
+	header_ = NULL;
+	records_ = NULL;
+	size_ = 0;
+}
+
+
+void SampleLog::append( const sample_record &record )
+{
+	if ( !header_ ) return;
+
+	uint64_t n = count_ + 1;
+	sample_record *slot = &records_[( n - 1 ) % header_->capacity];
+
+	// Mark the slot incomplete, write it, then publish index and count
+	__atomic_store_n( &slot->index, (uint64_t) 0, __ATOMIC_RELAXED );
+	__atomic_thread_fence( __ATOMIC_RELEASE );
+	memcpy( (char *) slot + sizeof( slot->index ), (const char *) &record + sizeof( record.index ),
+			sizeof( sample_record ) - sizeof( record.index ) );
+	__atomic_store_n( &slot->index, n, __ATOMIC_RELEASE );
+	__atomic_store_n( &header_->count, n, __ATOMIC_RELEASE );
+	count_ = n;
+}
+
+
+uint64_t SampleLog::count() const
+{
+	return count_;
+}
+
+
+static bool by_index( const sample_record &a, const sample_record &b )
+{
+	return a.index < b.index;
+}
+
+
+int sample_log_read( const char *path, sample_log_header *header, std::vector<sample_record> &records )
+{
+	struct stat st;
+	records.clear();
+
+	int fd = ::open( path, O_RDONLY );
+	if ( fd < 0 ) return -1;
+	if ( fstat( fd, &st ) != 0 || (size_t) st.st_size < sizeof( sample_log_header ) )
+	{
+		::close( fd );
+		return -1;
+	}
+	void *map = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+	::close( fd );
+	if ( map == MAP_FAILED ) return -1;
+
+	const sample_log_header *h = (const sample_log_header *) map;
+	if ( memcmp( h->magic, SAMPLE_LOG_MAGIC, sizeof( h->magic ) ) != 0 || h->version != SAMPLE_LOG_VERSION ||
+		 h->record_size != sizeof( sample_record ) || h->capacity == 0 ||
+		 h->capacity > ( st.st_size - sizeof( sample_log_header ) ) / sizeof( sample_record ) )
+	{
+		munmap( map, st.st_size );
+		return -1;
+	}
+	*header = *h;
+	header->count = __atomic_load_n( &h->count, __ATOMIC_ACQUIRE );
+
+	// Same index before and after the copy: the writer did not touch the slot meanwhile
+	const sample_record *slots = (const sample_record *) ( h + 1 );
+	records.reserve( std::min( header->count, header->capacity ) );
+	for ( uint64_t i = 0; i < header->capacity; i++ )
+	{
+		sample_record r;
+		uint64_t index = __atomic_load_n( &slots[i].index, __ATOMIC_ACQUIRE );
+		if ( index == 0 ) continue;
+		memcpy( &r, &slots[i], sizeof( r ) );
+		__atomic_thread_fence( __ATOMIC_ACQUIRE );
+		if ( __atomic_load_n( &slots[i].index, __ATOMIC_RELAXED ) != index ) continue;
+		r.index = index;
+		records.push_back( r );
+	}
+	munmap( map, st.st_size );
+
+	std::sort( records.begin(), records.end(), by_index );
+	return 0;
+}
@@ -0,0 +1,84 @@
+//======================================================================
+/**
+ *  @file
+ *  tactile.cpp
+ *
+ *  @section tactile.cpp_general General file information
+ *
+ *  @brief
+ *  Decoding of the finger sensor data of the measure scripts.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section tactile.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include "wsg_50/tactile.h"
+
+// The vector loads take the counts in host order: little endian hosts only
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#define TACTILE_SSE2
+#elif defined( __ARM_NEON )
+#include <arm_neon.h>
+#define TACTILE_NEON
+#endif
+#endif
+
+
+//------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------
+
+void tactile_decode_scalar( const unsigned char *raw, float *volts, int count )
+{
+	const float scale = TACTILE_VREF / TACTILE_ADC_RANGE;
+
+	for ( int i = 0; i < count; i++ )
+		volts[i] = (float) ( raw[2 * i] | ( raw[2 * i + 1] << 8 ) ) * scale;
+}
+
+
+void tactile_decode( const unsigned char *raw, float *volts, int count )
+{
+	int i = 0;
+
+#if defined( TACTILE_SSE2 )
+	const __m128 scale = _mm_set1_ps( TACTILE_VREF / TACTILE_ADC_RANGE );
+	const __m128i zero = _mm_setzero_si128();
+
+	// 8 counts: widen to 32 bit, convert, scale
+	for ( ; i + 8 <= count; i += 8 )
+	{
+		__m128i counts = _mm_loadu_si128( (const __m128i *) ( raw + 2 * i ) );
+		__m128 lo = _mm_cvtepi32_ps( _mm_unpacklo_epi16( counts, zero ) );
+		__m128 hi = _mm_cvtepi32_ps( _mm_unpackhi_epi16( counts, zero ) );
+		_mm_storeu_ps( volts + i, _mm_mul_ps( lo, scale ) );
+		_mm_storeu_ps( volts + i + 4, _mm_mul_ps( hi, scale ) );
+	}
+#elif defined( TACTILE_NEON )
+	const float32x4_t scale = vdupq_n_f32( TACTILE_VREF / TACTILE_ADC_RANGE );
+
+	for ( ; i + 8 <= count; i += 8 )
+	{
+		uint16x8_t counts = vreinterpretq_u16_u8( vld1q_u8( raw + 2 * i ) );
+		float32x4_t lo = vcvtq_f32_u32( vmovl_u16( vget_low_u16( counts ) ) );
+		float32x4_t hi = vcvtq_f32_u32( vmovl_u16( vget_high_u16( counts ) ) );
+		vst1q_f32( volts + i, vmulq_f32( lo, scale ) );
+		vst1q_f32( volts + i + 4, vmulq_f32( hi, scale ) );
+	}
+#endif
+
+	tactile_decode_scalar( raw + 2 * i, volts + i, count - i );
+}
@@ -0,0 +1,403 @@
+//======================================================================
+/**
+ *  @file
+ *  tactile_calibration.cpp
+ *
+ *  @section tactile_calibration.cpp_general General file information
+ *
+ *  @brief
+ *  Per-taxel calibration of the finger sensor voltages.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section tactile_calibration.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "wsg_50/tactile_calibration.h"
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#define CALIBRATION_SSE2
+#elif defined( __ARM_NEON )
+#include <arm_neon.h>
+#define CALIBRATION_NEON
+#endif
+
+
+//------------------------------------------------------------------------
+// Support functions
+//------------------------------------------------------------------------
+
+/** \brief Resample (V, kPa) points with increasing V on the uniform table grid */
+static void resample( const std::vector<float> &volts, const std::vector<float> &kpa, float *lut )
+{
+	size_t k = 0;
+
+	for ( int j = 0; j < TACTILE_LUT_POINTS; j++ )
+	{
+		float v = j * TACTILE_VREF / ( TACTILE_LUT_POINTS - 1 );
+		while ( k + 1 < volts.size() && volts[k + 1] < v ) k++;
+
+		if ( v <= volts.front() ) lut[j] = kpa.front();
+		else if ( v >= volts.back() ) lut[j] = kpa.back();
+		else lut[j] = kpa[k] + ( v - volts[k] ) * ( kpa[k + 1] - kpa[k] ) / ( volts[k + 1] - volts[k] );
+	}
+}
+
+
+/** \brief A token as a finite number */
+static bool parse_number( const char *token, float *value )
+{
+	char *end;
+
+	if ( token == NULL ) return false;
+	*value = strtof( token, &end );
+	return end != token && *end == '\0' && isfinite( *value );
+}
+
+
+/** \brief Next token of the line as a number */
+static bool next_number( char **save, float *value )
+{
+	return parse_number( strtok_r( NULL, " \t\r\n", save ), value );
+}
+
+
+/** \brief Nothing left on the line */
+static bool line_end( char **save )
+{
+	return strtok_r( NULL, " \t\r\n", save ) == NULL;
+}
+
+
+//------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------
+
+TactileCalibration::TactileCalibration()
+{
+	memset( fingers_, 0, sizeof( fingers_ ) );
+	area_ = 3.4f * 3.4f;
+	threshold_ = 0.0f;
+	loaded_ = false;
+	set_geometry( 3.4f, 3.4f );
+}
+
+
+void TactileCalibration::set_geometry( float pitch_row, float pitch_col )
+{
+	for ( int i = 0; i < TACTILE_TAXELS; i++ )
+	{
+		x_[i] = ( i % TACTILE_COLS - ( TACTILE_COLS - 1 ) / 2.0f ) * pitch_col;
+		y_[i] = ( i / TACTILE_COLS - ( TACTILE_ROWS - 1 ) / 2.0f ) * pitch_row;
+	}
+}
+
+
+int TactileCalibration::load( const char *path, std::string *error )
+{
+	FILE *file = fopen( path, "r" );
+	if ( file == NULL )
+	{
+		if ( error ) *error = std::string( "Can't open " ) + path + ": " + strerror( errno );
+		return -1;
+	}
+
+	TactileCalibration cal;
+	std::vector<float> volts, kpa;
+	char line[4096], msg[128] = "";
+	int number = 0;
+	unsigned int calibrated[2] = { 0, 0 };		// Taxel bit masks
+
+	while ( msg[0] == '\0' && fgets( line, sizeof( line ), file ) != NULL )
+	{
+		number++;
+		char *comment = strchr( line, '#' );
+		if ( comment ) *comment = '\0';
+
+		char *save;
+		char *key = strtok_r( line, " \t\r\n", &save );
+		if ( key == NULL ) continue;
+
+		float a, b;
+		if ( strcmp( key, "pitch" ) == 0 )
+		{
+			if ( !next_number( &save, &a ) || !next_number( &save, &b ) || a <= 0.0f || b <= 0.0f || !line_end( &save ) )
+				snprintf( msg, sizeof( msg ), "line %d: pitch <row mm> <col mm> expected", number );
+			else
+				cal.set_geometry( a, b );
+		}
+		else if ( strcmp( key, "area" ) == 0 )
+		{
+			if ( !next_number( &save, &a ) || a <= 0.0f || !line_end( &save ) )
+				snprintf( msg, sizeof( msg ), "line %d: area <mm^2> expected", number );
+			else
+				cal.area_ = a;
+		}
+		else if ( strcmp( key, "threshold" ) == 0 )
+		{
+			if ( !next_number( &save, &a ) || a < 0.0f || !line_end( &save ) )
+				snprintf( msg, sizeof( msg ), "line %d: threshold <kPa> expected", number );
+			else
+				cal.threshold_ = a;
+		}
+		else
+		{
+			// <finger> <taxel> linear|table ...
+			char *taxel = strtok_r( NULL, " \t\r\n", &save );
+			char *model = strtok_r( NULL, " \t\r\n", &save );
+			char *end;
+			long finger = strtol( key, &end, 10 );
+			if ( *end != '\0' || finger < 0 || finger > 1 || taxel == NULL || model == NULL )
+			{
+				snprintf( msg, sizeof( msg ), "line %d: unknown statement \"%s\"", number, key );
+				break;
+			}
+			int first = 0, last = TACTILE_TAXELS - 1;
+			if ( strcmp( taxel, "*" ) != 0 )
+			{
+				first = last = (int) strtol( taxel, &end, 10 );
+				if ( *end != '\0' || first < 0 || first >= TACTILE_TAXELS )
+				{
+					snprintf( msg, sizeof( msg ), "line %d: taxel 0..%d or * expected", number, TACTILE_TAXELS - 1 );
+					break;
+				}
+			}
+
+			finger_table &f = cal.fingers_[finger];
+			if ( strcmp( model, "linear" ) == 0 )
+			{
+				if ( !next_number( &save, &a ) || !next_number( &save, &b ) || !line_end( &save ) )
+				{
+					snprintf( msg, sizeof( msg ), "line %d: linear <offset V> <gain kPa/V> expected", number );
+					break;
+				}
+				for ( int i = first; i <= last; i++ )
+				{
+					f.offset[i] = a;
+					f.gain[i] = b;
+					f.table[i] = 0;
+				}
+			}
+			else if ( strcmp( model, "table" ) == 0 )
+			{
+				bool valid = true;
+				char *token;
+				volts.clear();
+				kpa.clear();
+				while ( valid && ( token = strtok_r( NULL, " \t\r\n", &save ) ) != NULL )
+				{
+					valid = parse_number( token, &a ) && next_number( &save, &b ) &&
+							( volts.empty() || a > volts.back() );
+					volts.push_back( a );
+					kpa.push_back( b );
+				}
+				if ( !valid || volts.size() < 2 )
+				{
+					snprintf( msg, sizeof( msg ), "line %d: table needs 2 or more <V> <kPa> pairs, V increasing", number );
+					break;
+				}
+				for ( int i = first; i <= last; i++ )
+				{
+					f.table[i] = ~0u;
+					resample( volts, kpa, f.lut[i] );
+				}
+			}
+			else
+			{
+				snprintf( msg, sizeof( msg ), "line %d: linear or table expected", number );
+				break;
+			}
+			for ( int i = first; i <= last; i++ ) calibrated[finger] |= 1u << i;
+		}
+	}
+	if ( msg[0] == '\0' && ferror( file ) )
+		snprintf( msg, sizeof( msg ), "read error" );
+	fclose( file );
+
+	// No partial calibration: a finger has all its taxels or none
+	if ( msg[0] == '\0' && calibrated[0] == 0 && calibrated[1] == 0 )
+		snprintf( msg, sizeof( msg ), "no taxel calibrated" );
+	for ( int finger = 0; finger < 2 && msg[0] == '\0'; finger++ )
+		for ( int i = 0; i < TACTILE_TAXELS && calibrated[finger] != 0; i++ )
+			if ( !( calibrated[finger] & ( 1u << i ) ) )
+			{
+				snprintf( msg, sizeof( msg ), "finger %d: taxel %d not calibrated", finger, i );
+				break;
+			}
+
+	if ( msg[0] != '\0' )
+	{
+		if ( error ) *error = std::string( path ) + ": " + msg;
+		return -1;
+	}
+
+	cal.loaded_ = true;
+	*this = cal;
+	return 0;
+}
+
+
+float TactileCalibration::lookup( int finger, int taxel, float volts ) const
+{
+	const float *lut = fingers_[finger].lut[taxel];
+	float u = volts * ( ( TACTILE_LUT_POINTS - 1 ) / TACTILE_VREF );
+
+	if ( !( u > 0.0f ) ) u = 0.0f;
+	if ( u > TACTILE_LUT_POINTS - 1 ) u = TACTILE_LUT_POINTS - 1;
+	int j = (int) u;
+	if ( j > TACTILE_LUT_POINTS - 2 ) j = TACTILE_LUT_POINTS - 2;
+	return lut[j] + ( u - j ) * ( lut[j + 1] - lut[j] );
+}
+
+
+void TactileCalibration::finish( tactile_map *map, float sum, float sum_x, float sum_y ) const
+{
+	// kPa * mm^2 = mN
+	map->force = sum * area_ * 1.0E-3f;
+	map->cop_x = sum > 0.0f ? sum_x / sum : NAN;
+	map->cop_y = sum > 0.0f ? sum_y / sum : NAN;
+}
+
+
+void TactileCalibration::apply_scalar( int finger, const float *volts, tactile_map *map ) const
+{
+	const finger_table &f = fingers_[finger];
+	float sum = 0.0f, sum_x = 0.0f, sum_y = 0.0f;
+
+	for ( int i = 0; i < TACTILE_TAXELS; i++ )
+	{
+		float p = f.table[i] ? lookup( finger, i, volts[i] ) : f.gain[i] * ( volts[i] - f.offset[i] );
+		if ( !( p > threshold_ ) ) p = 0.0f;
+		map->pressure[i] = p;
+		sum += p;
+		sum_x += p * x_[i];
+		sum_y += p * y_[i];
+	}
+	finish( map, sum, sum_x, sum_y );
+}
+
+
+void TactileCalibration::apply( int finger, const float *volts, tactile_map *map ) const
+{
+#if defined( CALIBRATION_SSE2 )
+	const finger_table &f = fingers_[finger];
+	const __m128 threshold = _mm_set1_ps( threshold_ );
+	const __m128 scale = _mm_set1_ps( ( TACTILE_LUT_POINTS - 1 ) / TACTILE_VREF );
+	const __m128 last = _mm_set1_ps( TACTILE_LUT_POINTS - 1 );
+	const __m128i last_segment = _mm_set1_epi32( TACTILE_LUT_POINTS - 2 );
+	__m128 s = _mm_setzero_ps(), sx = _mm_setzero_ps(), sy = _mm_setzero_ps();
+	int i;
+
+	for ( i = 0; i + 4 <= TACTILE_TAXELS; i += 4 )
+	{
+		__m128 v = _mm_loadu_ps( volts + i );
+		__m128 p = _mm_mul_ps( _mm_sub_ps( v, _mm_loadu_ps( f.offset + i ) ), _mm_loadu_ps( f.gain + i ) );
+
+		__m128 table = _mm_loadu_ps( (const float *) ( f.table + i ) );
+		if ( _mm_movemask_ps( table ) )
+		{
+			// Table lookup of the 4 lanes: index and fraction in registers, gathered by lane
+			__m128 u = _mm_min_ps( _mm_max_ps( _mm_mul_ps( v, scale ), _mm_setzero_ps() ), last );
+			__m128i j = _mm_cvttps_epi32( u );
+			__m128i over = _mm_cmpgt_epi32( j, last_segment );
+			j = _mm_or_si128( _mm_and_si128( over, last_segment ), _mm_andnot_si128( over, j ) );
+			__m128 frac = _mm_sub_ps( u, _mm_cvtepi32_ps( j ) );
+			int j0 = _mm_cvtsi128_si32( j );
+			int j1 = _mm_cvtsi128_si32( _mm_shuffle_epi32( j, 0x55 ) );
+			int j2 = _mm_cvtsi128_si32( _mm_shuffle_epi32( j, 0xAA ) );
+			int j3 = _mm_cvtsi128_si32( _mm_shuffle_epi32( j, 0xFF ) );
+			__m128 lo = _mm_setr_ps( f.lut[i][j0], f.lut[i + 1][j1], f.lut[i + 2][j2], f.lut[i + 3][j3] );
+			__m128 hi = _mm_setr_ps( f.lut[i][j0 + 1], f.lut[i + 1][j1 + 1], f.lut[i + 2][j2 + 1], f.lut[i + 3][j3 + 1] );
+			__m128 t = _mm_add_ps( lo, _mm_mul_ps( frac, _mm_sub_ps( hi, lo ) ) );
+			p = _mm_or_ps( _mm_and_ps( table, t ), _mm_andnot_ps( table, p ) );
+		}
+
+		p = _mm_and_ps( p, _mm_cmpgt_ps( p, threshold ) );
+		_mm_storeu_ps( map->pressure + i, p );
+		s = _mm_add_ps( s, p );
+		sx = _mm_add_ps( sx, _mm_mul_ps( p, _mm_loadu_ps( x_ + i ) ) );
+		sy = _mm_add_ps( sy, _mm_mul_ps( p, _mm_loadu_ps( y_ + i ) ) );
+	}
+
+	float lanes[3][4];
+	_mm_storeu_ps( lanes[0], s );
+	_mm_storeu_ps( lanes[1], sx );
+	_mm_storeu_ps( lanes[2], sy );
+#elif defined( CALIBRATION_NEON )
+	const finger_table &f = fingers_[finger];
+	const float32x4_t threshold = vdupq_n_f32( threshold_ );
+	const float32x4_t scale = vdupq_n_f32( ( TACTILE_LUT_POINTS - 1 ) / TACTILE_VREF );
+	const float32x4_t last = vdupq_n_f32( TACTILE_LUT_POINTS - 1 );
+	const int32x4_t last_segment = vdupq_n_s32( TACTILE_LUT_POINTS - 2 );
+	float32x4_t s = vdupq_n_f32( 0.0f ), sx = s, sy = s;
+	int i;
+
+	for ( i = 0; i + 4 <= TACTILE_TAXELS; i += 4 )
+	{
+		float32x4_t v = vld1q_f32( volts + i );
+		float32x4_t p = vmulq_f32( vsubq_f32( v, vld1q_f32( f.offset + i ) ), vld1q_f32( f.gain + i ) );
+
+		uint32x4_t table = vld1q_u32( f.table + i );
+		if ( vgetq_lane_u32( table, 0 ) | vgetq_lane_u32( table, 1 ) | vgetq_lane_u32( table, 2 ) | vgetq_lane_u32( table, 3 ) )
+		{
+			float32x4_t u = vminq_f32( vmaxq_f32( vmulq_f32( v, scale ), vdupq_n_f32( 0.0f ) ), last );
+			int32x4_t j = vminq_s32( vcvtq_s32_f32( u ), last_segment );
+			float32x4_t frac = vsubq_f32( u, vcvtq_f32_s32( j ) );
+			int j0 = vgetq_lane_s32( j, 0 ), j1 = vgetq_lane_s32( j, 1 );
+			int j2 = vgetq_lane_s32( j, 2 ), j3 = vgetq_lane_s32( j, 3 );
+			float lo_lanes[4] = { f.lut[i][j0], f.lut[i + 1][j1], f.lut[i + 2][j2], f.lut[i + 3][j3] };
+			float hi_lanes[4] = { f.lut[i][j0 + 1], f.lut[i + 1][j1 + 1], f.lut[i + 2][j2 + 1], f.lut[i + 3][j3 + 1] };
+			float32x4_t lo = vld1q_f32( lo_lanes ), hi = vld1q_f32( hi_lanes );
+			p = vbslq_f32( table, vmlaq_f32( lo, frac, vsubq_f32( hi, lo ) ), p );
+		}
+
+		p = vreinterpretq_f32_u32( vandq_u32( vreinterpretq_u32_f32( p ), vcgtq_f32( p, threshold ) ) );
+		vst1q_f32( map->pressure + i, p );
+		s = vaddq_f32( s, p );
+		sx = vmlaq_f32( sx, p, vld1q_f32( x_ + i ) );
+		sy = vmlaq_f32( sy, p, vld1q_f32( y_ + i ) );
+	}
+
+	float lanes[3][4];
+	vst1q_f32( lanes[0], s );
+	vst1q_f32( lanes[1], sx );
+	vst1q_f32( lanes[2], sy );
+#endif
+
+#if defined( CALIBRATION_SSE2 ) || defined( CALIBRATION_NEON )
+	float sum = lanes[0][0] + lanes[0][1] + lanes[0][2] + lanes[0][3];
+	float sum_x = lanes[1][0] + lanes[1][1] + lanes[1][2] + lanes[1][3];
+	float sum_y = lanes[2][0] + lanes[2][1] + lanes[2][2] + lanes[2][3];
+
+	for ( ; i < TACTILE_TAXELS; i++ )
+	{
+		float p = f.table[i] ? lookup( finger, i, volts[i] ) : f.gain[i] * ( volts[i] - f.offset[i] );
+		if ( !( p > threshold_ ) ) p = 0.0f;
+		map->pressure[i] = p;
+		sum += p;
+		sum_x += p * x_[i];
+		sum_y += p * y_[i];
+	}
+	finish( map, sum, sum_x, sum_y );
+#else
+	apply_scalar( finger, volts, map );
+#endif
+}
@@ -0,0 +1,544 @@
+//======================================================================
+/**
+ *  @file
+ *  wsg50_bench.cpp
+ *
+ *  @section wsg50_bench.cpp_general General file information
+ *
+ *  @brief
+ *  Latency/throughput benchmark for real or emulated grippers.
+ *
+ *  Connects over TCP, UDP or serial using wsg50_core (no ROS), runs a
+ *  set of scenarios and reports throughput, round trip time percentiles
+ *  and jitter as a table and optionally as JSON.
+ *
+ *  Scenarios:
+ *    poll_opening, poll_speed, poll_force, poll_state
+ *                     Built-in getters 0x43, 0x44, 0x45, 0x40
+ *    script_measure   Script command 0xB0 (measure only)
+ *    script_position  Script command 0xB1, target is the current width
+ *    script_speed     Script command 0xB2 with zero speed
+ *    auto_update      Auto update streaming of 0x43/0x44/0x45,
+ *                     reports the inter-arrival time instead of RTT
+ *    move_poll        Non-blocking MOVE between --move-min and --move-max
+ *                     every --move-every polls of the opening (moves the fingers!)
+ *    all              All of the above except move_poll
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section wsg50_bench.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "wsg_50/common.h"
+#include "wsg_50/cmd.h"
+#include "wsg_50/msg.h"
+#include "wsg_50/functions.h"
+
+
+//------------------------------------------------------------------------
+// Typedefs, enums, structs
+//------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock bench_clock;
+
+struct bench_options
+{
+	std::string protocol;
+	std::string ip;
+	int port;
+	int local_port;
+	std::string device;
+	int bitrate;
+	std::vector<std::string> scenarios;
+	int count;
+	int warmup;
+	int interval_ms;
+	float move_min, move_max, move_speed;
+	int move_every;
+	std::string json;
+	bool table;
+};
+
+struct bench_result
+{
+	std::string scenario;
+	std::string metric;					// "rtt" or "interval"
+	int count;
+	int errors;
+	int skipped;						// Frames of other commands received in between
+	double duration_s;
+	std::vector<double> samples_ms;
+};
+
+
+//------------------------------------------------------------------------
+// Local function prototypes
+//------------------------------------------------------------------------
+
+static double ms_since( const bench_clock::time_point &t0 );
+
+
+//------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------
+
+static double ms_since( const bench_clock::time_point &t0 )
+{
+	return std::chrono::duration<double, std::milli>( bench_clock::now() - t0 ).count();
+}
+
+
+static double percentile( const std::vector<double> &sorted, double p )
+{
+	if ( sorted.empty() ) return NAN;
+	size_t i = (size_t) ceil( p / 100.0 * sorted.size() );
+	if ( i > 0 ) i--;
+	if ( i >= sorted.size() ) i = sorted.size() - 1;
+	return sorted[i];
+}
+
+
+static double mean( const std::vector<double> &v )
+{
+	double s = 0.0;
+	if ( v.empty() ) return NAN;
+	for ( size_t i = 0; i < v.size(); i++ ) s += v[i];
+	return s / v.size();
+}
+
+
+static double stddev( const std::vector<double> &v )
+{
+	double m = mean( v ), s = 0.0;
+	if ( v.size() < 2 ) return 0.0;
+	for ( size_t i = 0; i < v.size(); i++ ) s += ( v[i] - m ) * ( v[i] - m );
+	return sqrt( s / ( v.size() - 1 ) );
+}
+
+
+/**
+ * Send a command and wait for the response with the same id.
+ * Frames of other commands (e.g. MOVE status) are counted and dropped.
+ *
+ * @return Response status, -1 on communication error
+ */
+
+static int exchange( unsigned char id, unsigned char *payload, unsigned int len, int *skipped )
+{
+	msg_t msg;
+	int status;
+
+	msg.id = id; msg.len = len; msg.data = payload;
+	if ( msg_send( &msg ) < 0 ) return -1;
+
+	memset( &msg, 0, sizeof( msg ) );
+	for ( ;; )
+	{
+		msg_free( &msg );
+		if ( msg_receive( &msg ) < 0 ) return -1;
+		if ( msg.id == id ) break;
+		( *skipped )++;
+	}
+
+	status = msg.len >= 2 ? (int) cmd_get_response_status( msg.data ) : -1;
+	msg_free( &msg );
+	return status;
+}
+
+
+static void run_poll( unsigned char id, const bench_options &opt, bench_result &res )
+{
+	unsigned char payload[3] = { 0, 0, 0 };
+
+	for ( int i = 0; i < opt.warmup; i++ ) exchange( id, payload, 3, &res.skipped );
+	res.skipped = 0;
+
+	bench_clock::time_point start = bench_clock::now();
+	for ( int i = 0; i < opt.count; i++ )
+	{
+		bench_clock::time_point t0 = bench_clock::now();
+		int status = exchange( id, payload, 3, &res.skipped );
+		double rtt = ms_since( t0 );
+		if ( status != E_SUCCESS ) { res.errors++; if ( status < 0 ) break; continue; }
+		res.samples_ms.push_back( rtt );
+	}
+	res.duration_s = ms_since( start ) / 1000.0;
+}
+
+
+static void run_script( unsigned char cmd_type, const bench_options &opt, bench_result &res )
+{
+	gripper_response info;
+	float width = 0.0, speed = 0.0;
+
+	memset( &info, 0, sizeof( info ) );
+
+	// Position control targets the current width, so nothing moves
+	if ( cmd_type == 1 )
+	{
+		if ( !script_measure_move( 0, 0, 0, info ) ) { res.errors++; return; }
+		width = info.position;
+		speed = opt.move_speed;
+	}
+
+	for ( int i = 0; i < opt.warmup; i++ ) script_measure_move( cmd_type, width, speed, info );
+
+	bench_clock::time_point start = bench_clock::now();
+	for ( int i = 0; i < opt.count; i++ )
+	{
+		bench_clock::time_point t0 = bench_clock::now();
+		int ok = script_measure_move( cmd_type, width, speed, info );
+		double rtt = ms_since( t0 );
+		if ( !ok ) { res.errors++; continue; }
+		res.samples_ms.push_back( rtt );
+	}
+	res.duration_s = ms_since( start ) / 1000.0;
+}
+
+
+static void set_auto_update( int interval_ms )
+{
+	unsigned char payload[3];
+	msg_t msg;
+
+	memset( payload, 0, 3 );
+	if ( interval_ms > 0 )
+	{
+		payload[0] = 0x01;
+		payload[1] = lo( interval_ms );
+		payload[2] = hi( interval_ms );
+	}
+
+	for ( unsigned char id = 0x43; id <= 0x45; id++ )
+	{
+		msg.id = id; msg.len = 3; msg.data = payload;
+		msg_send( &msg );
+	}
+}
+
+
+static void run_auto_update( const bench_options &opt, bench_result &res )
+{
+	unsigned char barrier[3] = { 0, 0, 0 };
+	msg_t msg;
+	int received = 0, drained = 0;
+	bench_clock::time_point last, start;
+
+	set_auto_update( opt.interval_ms );
+
+	memset( &msg, 0, sizeof( msg ) );
+	start = bench_clock::now();
+	while ( received < opt.warmup + opt.count )
+	{
+		msg_free( &msg );
+		if ( msg_receive( &msg ) < 0 ) { res.errors++; break; }
+		if ( msg.id != 0x43 ) { res.skipped++; continue; }
+		if ( msg.len != 6 || cmd_get_response_status( msg.data ) != E_SUCCESS ) { res.errors++; continue; }
+
+		bench_clock::time_point now = bench_clock::now();
+		if ( received == opt.warmup ) start = now;
+		else if ( received > opt.warmup ) res.samples_ms.push_back( std::chrono::duration<double, std::milli>( now - last ).count() );
+		last = now;
+		received++;
+	}
+	res.duration_s = std::chrono::duration<double>( last - start ).count();
+
+	// Disable automatic updates. The state request is answered after the
+	// disable requests, so everything streamed before is drained with it.
+	set_auto_update( 0 );
+	msg_free( &msg );
+	exchange( 0x40, barrier, 3, &drained );
+}
+
+
+static void run_move_poll( const bench_options &opt, bench_result &res )
+{
+	unsigned char poll[3] = { 0, 0, 0 };
+	unsigned char move[9];
+	bool toggle = false;
+	msg_t msg;
+
+	bench_clock::time_point start = bench_clock::now();
+	for ( int i = 0; i < opt.count; i++ )
+	{
+		if ( i % opt.move_every == 0 )
+		{
+			float width = toggle ? opt.move_max : opt.move_min;
+			toggle = !toggle;
+
+			// Stop on block, absolute; response is skipped by exchange()
+			move[0] = 0x02;
+			memcpy( &move[1], &width, sizeof( float ) );
+			memcpy( &move[5], &opt.move_speed, sizeof( float ) );
+			msg.id = 0x21; msg.len = 9; msg.data = move;
+			if ( msg_send( &msg ) < 0 ) { res.errors++; break; }
+		}
+
+		bench_clock::time_point t0 = bench_clock::now();
+		int status = exchange( 0x43, poll, 3, &res.skipped );
+		double rtt = ms_since( t0 );
+		if ( status != E_SUCCESS ) { res.errors++; if ( status < 0 ) break; continue; }
+		res.samples_ms.push_back( rtt );
+	}
+	res.duration_s = ms_since( start ) / 1000.0;
+
+	// Stop the last motion and drop its responses
+	exchange( 0x22, NULL, 0, &res.skipped );
+}
+
+
+static bool run_scenario( const std::string &name, const bench_options &opt, bench_result &res )
+{
+	res.scenario = name;
+	res.metric = "rtt";
+	res.count = 0; res.errors = 0; res.skipped = 0;
+	res.duration_s = 0.0;
+
+	if ( name == "poll_opening" ) run_poll( 0x43, opt, res );
+	else if ( name == "poll_speed" ) run_poll( 0x44, opt, res );
+	else if ( name == "poll_force" ) run_poll( 0x45, opt, res );
+	else if ( name == "poll_state" ) run_poll( 0x40, opt, res );
+	else if ( name == "script_measure" ) run_script( 0, opt, res );
+	else if ( name == "script_position" ) run_script( 1, opt, res );
+	else if ( name == "script_speed" ) run_script( 2, opt, res );
+	else if ( name == "auto_update" ) { res.metric = "interval"; run_auto_update( opt, res ); }
+	else if ( name == "move_poll" ) run_move_poll( opt, res );
+	else
+	{
+		fprintf( stderr, "Unknown scenario '%s'\n", name.c_str() );
+		return false;
+	}
+
+	res.count = (int) res.samples_ms.size();
+	std::sort( res.samples_ms.begin(), res.samples_ms.end() );
+	return true;
+}
+
+
+static void print_table( const std::vector<bench_result> &results )
+{
+	printf( "\n%-16s %-8s %6s %5s %5s %9s %8s %8s %8s %8s %8s %8s\n",
+			"scenario", "metric", "n", "err", "skip", "rate[Hz]", "min", "p50", "p90", "p99", "max", "jitter" );
+	for ( size_t i = 0; i < results.size(); i++ )
+	{
+		const bench_result &r = results[i];
+		double rate = r.duration_s > 0.0 ? r.count / r.duration_s : 0.0;
+		printf( "%-16s %-8s %6d %5d %5d %9.1f %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f\n",
+				r.scenario.c_str(), r.metric.c_str(), r.count, r.errors, r.skipped, rate,
+				percentile( r.samples_ms, 0 ), percentile( r.samples_ms, 50 ), percentile( r.samples_ms, 90 ),
+				percentile( r.samples_ms, 99 ), percentile( r.samples_ms, 100 ), stddev( r.samples_ms ) );
+	}
+	printf( "(times in ms, jitter = standard deviation)\n" );
+}
+
+
+static std::string json_number( double v )
+{
+	char buf[32];
+	if ( std::isnan( v ) ) return "null";
+	snprintf( buf, sizeof( buf ), "%.6g", v );
+	return buf;
+}
+
+
+static bool write_json( const std::string &file, const bench_options &opt, const std::vector<bench_result> &results )
+{
+	FILE *f = file == "-" ? stdout : fopen( file.c_str(), "w" );
+	if ( !f )
+	{
+		fprintf( stderr, "Cannot open '%s' for writing\n", file.c_str() );
+		return false;
+	}
+
+	fprintf( f, "{\n  \"protocol\": \"%s\",\n", opt.protocol.c_str() );
+	if ( opt.protocol == "serial" ) fprintf( f, "  \"device\": \"%s\",\n  \"bitrate\": %d,\n", opt.device.c_str(), opt.bitrate );
+	else fprintf( f, "  \"ip\": \"%s\",\n  \"port\": %d,\n", opt.ip.c_str(), opt.port );
+	fprintf( f, "  \"results\": [\n" );
+	for ( size_t i = 0; i < results.size(); i++ )
+	{
+		const bench_result &r = results[i];
+		double rate = r.duration_s > 0.0 ? r.count / r.duration_s : 0.0;
+		fprintf( f, "    {\"scenario\": \"%s\", \"metric\": \"%s\", \"count\": %d, \"errors\": %d, \"skipped\": %d, "
+					"\"duration_s\": %s, \"rate_hz\": %s, \"min_ms\": %s, \"p50_ms\": %s, \"p90_ms\": %s, "
+					"\"p99_ms\": %s, \"max_ms\": %s, \"mean_ms\": %s, \"jitter_ms\": %s}%s\n",
+				 r.scenario.c_str(), r.metric.c_str(), r.count, r.errors, r.skipped,
+				 json_number( r.duration_s ).c_str(), json_number( rate ).c_str(),
+				 json_number( percentile( r.samples_ms, 0 ) ).c_str(), json_number( percentile( r.samples_ms, 50 ) ).c_str(),
+				 json_number( percentile( r.samples_ms, 90 ) ).c_str(), json_number( percentile( r.samples_ms, 99 ) ).c_str(),
+				 json_number( percentile( r.samples_ms, 100 ) ).c_str(), json_number( mean( r.samples_ms ) ).c_str(),
+				 json_number( stddev( r.samples_ms ) ).c_str(), i + 1 < results.size() ? "," : "" );
+	}
+	fprintf( f, "  ]\n}\n" );
+
+	if ( f != stdout ) fclose( f );
+	return true;
+}
+
+
+static void usage( const char *name )
+{
+	printf( "Usage: %s [options]\n"
+			"  -p, --protocol tcp|udp|serial   Transport (default tcp)\n"
+			"  -i, --ip ADDR                   Gripper address (default 192.168.1.20)\n"
+			"  -P, --port N                    Gripper port (default 1000)\n"
+			"  -l, --local-port N              Local UDP port (default 1501)\n"
+			"  -d, --device PATH               Serial device (default /dev/ttyUSB0)\n"
+			"  -b, --bitrate N                 Serial bitrate (default 115200)\n"
+			"  -s, --scenario LIST             Comma separated scenarios (default all)\n"
+			"  -n, --count N                   Samples per scenario (default 500)\n"
+			"  -w, --warmup N                  Warmup exchanges per scenario (default 20)\n"
+			"  -u, --interval MS               Auto update interval (default 5)\n"
+			"      --move-min MM               move_poll lower width (default 20)\n"
+			"      --move-max MM               move_poll upper width (default 80)\n"
+			"      --move-speed MM_S           Speed for moves (default 50)\n"
+			"      --move-every N              Polls per move (default 10)\n"
+			"  -j, --json FILE                 Write JSON report, - for stdout\n"
+			"  -q, --quiet                     Don't print the table\n"
+			"Scenarios: poll_opening poll_speed poll_force poll_state script_measure\n"
+			"           script_position script_speed auto_update move_poll all\n", name );
+}
+
+
+/**
+ * The main function
+ */
+
+int main( int argc, char **argv )
+{
+	bench_options opt;
+	std::vector<bench_result> results;
+	std::string scenarios = "all";
+	int res_con, c;
+
+	opt.protocol = "tcp";
+	opt.ip = "192.168.1.20";
+	opt.port = 1000;
+	opt.local_port = 1501;
+	opt.device = "/dev/ttyUSB0";
+	opt.bitrate = 115200;
+	opt.count = 500;
+	opt.warmup = 20;
+	opt.interval_ms = 5;
+	opt.move_min = 20.0; opt.move_max = 80.0; opt.move_speed = 50.0;
+	opt.move_every = 10;
+	opt.table = true;
+
+	static const struct option long_options[] =
+	{
+		{ "protocol", required_argument, 0, 'p' },
+		{ "ip", required_argument, 0, 'i' },
+		{ "port", required_argument, 0, 'P' },
+		{ "local-port", required_argument, 0, 'l' },
+		{ "device", required_argument, 0, 'd' },
+		{ "bitrate", required_argument, 0, 'b' },
+		{ "scenario", required_argument, 0, 's' },
+		{ "count", required_argument, 0, 'n' },
+		{ "warmup", required_argument, 0, 'w' },
+		{ "interval", required_argument, 0, 'u' },
+		{ "move-min", required_argument, 0, 1 },
+		{ "move-max", required_argument, 0, 2 },
+		{ "move-speed", required_argument, 0, 3 },
+		{ "move-every", required_argument, 0, 4 },
+		{ "json", required_argument, 0, 'j' },
+		{ "quiet", no_argument, 0, 'q' },
+		{ "help", no_argument, 0, 'h' },
+		{ 0, 0, 0, 0 }
+	};
+
+	while ( ( c = getopt_long( argc, argv, "p:i:P:l:d:b:s:n:w:u:j:qh", long_options, NULL ) ) != -1 )
+	{
+		switch ( c )
+		{
+			case 'p': opt.protocol = optarg; break;
+			case 'i': opt.ip = optarg; break;
+			case 'P': opt.port = atoi( optarg ); break;
+			case 'l': opt.local_port = atoi( optarg ); break;
+			case 'd': opt.device = optarg; break;
+			case 'b': opt.bitrate = atoi( optarg ); break;
+			case 's': scenarios = optarg; break;
+			case 'n': opt.count = atoi( optarg ); break;
+			case 'w': opt.warmup = atoi( optarg ); break;
+			case 'u': opt.interval_ms = atoi( optarg ); break;
+			case 1: opt.move_min = atof( optarg ); break;
+			case 2: opt.move_max = atof( optarg ); break;
+			case 3: opt.move_speed = atof( optarg ); break;
+			case 4: opt.move_every = atoi( optarg ); break;
+			case 'j': opt.json = optarg; break;
+			case 'q': opt.table = false; break;
+			case 'h': usage( argv[0] ); return 0;
+			default: usage( argv[0] ); return 1;
+		}
+	}
+
+	if ( opt.count <= 0 || opt.warmup < 0 || opt.interval_ms <= 0 || opt.move_every <= 0 )
+	{
+		fprintf( stderr, "Invalid count, warmup, interval or move-every\n" );
+		return 1;
+	}
+
+	// Expand scenario list
+	size_t pos = 0;
+	while ( pos <= scenarios.size() )
+	{
+		size_t end = scenarios.find( ',', pos );
+		if ( end == std::string::npos ) end = scenarios.size();
+		std::string s = scenarios.substr( pos, end - pos );
+		if ( s == "all" )
+		{
+			const char *all[] = { "poll_opening", "poll_speed", "poll_force", "poll_state",
+								  "script_measure", "script_position", "script_speed", "auto_update" };
+			opt.scenarios.insert( opt.scenarios.end(), all, all + sizeof( all ) / sizeof( all[0] ) );
+		}
+		else if ( !s.empty() ) opt.scenarios.push_back( s );
+		pos = end + 1;
+	}
+
+	if ( opt.protocol == "tcp" ) res_con = cmd_connect_tcp( opt.ip.c_str(), opt.port );
+	else if ( opt.protocol == "udp" ) res_con = cmd_connect_udp( opt.local_port, opt.ip.c_str(), opt.port );
+	else if ( opt.protocol == "serial" ) res_con = cmd_connect_serial( opt.device.c_str(), opt.bitrate );
+	else
+	{
+		fprintf( stderr, "Unknown protocol '%s'\n", opt.protocol.c_str() );
+		return 1;
+	}
+
+	if ( res_con != 0 )
+	{
+		fprintf( stderr, "Unable to connect, please check the port and address used.\n" );
+		return 1;
+	}
+
+	for ( size_t i = 0; i < opt.scenarios.size(); i++ )
+	{
+		bench_result r;
+		fprintf( stderr, "Running %s ...\n", opt.scenarios[i].c_str() );
+		if ( run_scenario( opt.scenarios[i], opt, r ) ) results.push_back( r );
+	}
+
+	cmd_disconnect();
+
+	if ( opt.table ) print_table( results );
+	if ( !opt.json.empty() && !write_json( opt.json, opt, results ) ) return 1;
+
+	return 0;
+}
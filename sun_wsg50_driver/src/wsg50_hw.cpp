@@ -0,0 +1,261 @@
+//======================================================================
+/**
+ *  @file
+ *  wsg50_hw.cpp
+ *
+ *  @section wsg50_hw.cpp_general General file information
+ *
+ *  @brief
+ *  ros_control hardware interface for the WSG50 (see wsg50_hw.h).
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section wsg50_hw.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+#include <chrono>
+
+#include <pluginlib/class_list_macros.h>
+
+#include "wsg_50/common.h"
+#include "wsg_50/cmd.h"
+#include "wsg_50/functions.h"
+#include "wsg_50/state_cache.h"
+#include "wsg_50/wsg50_hw.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define SCRIPT_SPEED_CONTROL	2		// 0xB0 + 2: speed command and measure
+
+
+//------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------
+
+WSG50HW::WSG50HW()
+	: position_( 0.0 ), velocity_( 0.0 ), effort_( 0.0 ),
+	  position_cmd_( 0.0 ), velocity_cmd_( 0.0 ), effort_cmd_( 0.0 ),
+	  mode_( HW_MODE_NONE ), running_( false ), connected_( false ),
+	  max_speed_( 420.0 ), position_gain_( 10.0 ), force_gain_( 1.0 ),
+	  stiffness_( 5000.0 ), read_force_( false )
+{
+}
+
+
+WSG50HW::~WSG50HW()
+{
+	running_ = false;
+	if ( io_thread_.joinable() ) io_thread_.join();
+	if ( connected_ ) cmd_disconnect();
+}
+
+
+bool WSG50HW::init( ros::NodeHandle &root_nh, ros::NodeHandle &robot_hw_nh )
+{
+	std::string ip, protocol, joint_prefix;
+	int port, local_port;
+	double grasping_force;
+	bool do_homing;
+	int res;
+
+	robot_hw_nh.param( "ip", ip, std::string( "192.168.1.20" ) );
+	robot_hw_nh.param( "port", port, 1000 );
+	robot_hw_nh.param( "local_port", local_port, 1501 );
+	robot_hw_nh.param( "protocol", protocol, std::string( "tcp" ) );
+	robot_hw_nh.param( "joint_prefix", joint_prefix, std::string( "" ) );
+	robot_hw_nh.param( "joint_name", joint_name_, joint_prefix + "gripper_joint" );
+	robot_hw_nh.param( "homing", do_homing, true );
+	robot_hw_nh.param( "grasping_force", grasping_force, 0.0 );
+	robot_hw_nh.param( "max_speed", max_speed_, 420.0 );
+	robot_hw_nh.param( "position_gain", position_gain_, 10.0 );
+	robot_hw_nh.param( "force_gain", force_gain_, 1.0 );
+	robot_hw_nh.param( "stiffness", stiffness_, 5000.0 );
+	robot_hw_nh.param( "read_force", read_force_, false );
+
+	ROS_INFO( "Connecting to %s:%d (%s) ...", ip.c_str(), port, protocol.c_str() );
+	if ( protocol == "udp" ) res = cmd_connect_udp( local_port, ip.c_str(), port );
+	else res = cmd_connect_tcp( ip.c_str(), port );
+	if ( res != 0 )
+	{
+		ROS_ERROR( "Unable to connect, please check the port and address used." );
+		return false;
+	}
+	connected_ = true;
+
+	if ( do_homing )
+	{
+		ROS_INFO( "Homing..." );
+		homing();
+	}
+	if ( grasping_force > 0.0 )
+	{
+		ROS_INFO( "Setting grasping force limit to %5.1f", grasping_force );
+		setGraspingForceLimit( grasping_force );
+	}
+
+	// One joint, exported through all interfaces
+	hardware_interface::JointStateHandle state_handle( joint_name_, &position_, &velocity_, &effort_ );
+	state_interface_.registerHandle( state_handle );
+	position_interface_.registerHandle( hardware_interface::JointHandle( state_handle, &position_cmd_ ) );
+	velocity_interface_.registerHandle( hardware_interface::JointHandle( state_handle, &velocity_cmd_ ) );
+	effort_interface_.registerHandle( hardware_interface::JointHandle( state_handle, &effort_cmd_ ) );
+
+	registerInterface( &state_interface_ );
+	registerInterface( &position_interface_ );
+	registerInterface( &velocity_interface_ );
+	registerInterface( &effort_interface_ );
+
+	running_ = true;
+	io_thread_ = std::thread( &WSG50HW::ioLoop, this );
+
+	ROS_INFO( "WSG50 hardware interface ready, joint %s", joint_name_.c_str() );
+	return true;
+}
+
+
+void WSG50HW::read( const ros::Time &time, const ros::Duration &period )
+{
+	gripper_state state = state_cache().snapshot();
+
+	position_ = state.value[CACHE_OPENING] / 1000.0;
+	velocity_ = state.value[CACHE_SPEED] / 1000.0;
+	effort_ = state.value[CACHE_FORCE];
+}
+
+
+void WSG50HW::write( const ros::Time &time, const ros::Duration &period )
+{
+	hw_command cmd;
+
+	cmd.mode = mode_;
+	switch ( mode_ )
+	{
+	case HW_MODE_POSITION: cmd.value = position_cmd_; break;
+	case HW_MODE_VELOCITY: cmd.value = velocity_cmd_; break;
+	case HW_MODE_EFFORT: cmd.value = effort_cmd_; break;
+	default: cmd.value = 0.0; break;
+	}
+	command_box_.post( cmd );
+}
+
+
+/** \brief Command mode of a controller on the finger joint, HW_MODE_NONE if it doesn't use it */
+static hw_mode_t controller_mode( const hardware_interface::ControllerInfo &info, const std::string &joint )
+{
+	for ( const hardware_interface::InterfaceResources &claimed : info.claimed_resources )
+	{
+		if ( !claimed.resources.count( joint ) ) continue;
+		if ( claimed.hardware_interface == "hardware_interface::PositionJointInterface" ) return HW_MODE_POSITION;
+		if ( claimed.hardware_interface == "hardware_interface::VelocityJointInterface" ) return HW_MODE_VELOCITY;
+		if ( claimed.hardware_interface == "hardware_interface::EffortJointInterface" ) return HW_MODE_EFFORT;
+	}
+	return HW_MODE_NONE;
+}
+
+
+bool WSG50HW::prepareSwitch( const std::list<hardware_interface::ControllerInfo> &start_list,
+							 const std::list<hardware_interface::ControllerInfo> &stop_list )
+{
+	int commanding = 0;
+
+	for ( const hardware_interface::ControllerInfo &info : start_list )
+		if ( controller_mode( info, joint_name_ ) != HW_MODE_NONE ) commanding++;
+
+	if ( commanding > 1 )
+	{
+		ROS_ERROR( "Only one controller can command %s", joint_name_.c_str() );
+		return false;
+	}
+	return true;
+}
+
+
+void WSG50HW::doSwitch( const std::list<hardware_interface::ControllerInfo> &start_list,
+						const std::list<hardware_interface::ControllerInfo> &stop_list )
+{
+	for ( const hardware_interface::ControllerInfo &info : stop_list )
+		if ( controller_mode( info, joint_name_ ) == mode_ ) mode_ = HW_MODE_NONE;
+
+	for ( const hardware_interface::ControllerInfo &info : start_list )
+	{
+		hw_mode_t mode = controller_mode( info, joint_name_ );
+		if ( mode == HW_MODE_NONE ) continue;
+
+		// Start from the current state, the controller overwrites it in starting()
+		position_cmd_ = position_;
+		velocity_cmd_ = 0.0;
+		effort_cmd_ = effort_;
+		mode_ = mode;
+	}
+}
+
+
+/** \brief Speed command [mm/s] for the script from a joint command */
+float WSG50HW::speedCommand( const hw_command &cmd )
+{
+	gripper_state state = state_cache().snapshot();
+	double speed;
+
+	switch ( cmd.mode )
+	{
+	case HW_MODE_POSITION:
+		speed = position_gain_ * ( cmd.value * 1000.0 - state.value[CACHE_OPENING] );
+		break;
+	case HW_MODE_VELOCITY:
+		speed = cmd.value * 1000.0;
+		break;
+	case HW_MODE_EFFORT:
+		speed = -force_gain_ * ( fabs( cmd.value ) - fabs( state.value[CACHE_FORCE] ) ) / stiffness_ * 1000.0;
+		break;
+	default:
+		speed = 0.0;
+		break;
+	}
+
+	return (float) fmin( fmax( speed, -max_speed_ ), max_speed_ );
+}
+
+
+/**
+ * I/O thread: one speed command/measure exchange per cycle (plus a force
+ * read), paced by the gripper.
+ */
+
+void WSG50HW::ioLoop()
+{
+	hw_command cmd = { HW_MODE_NONE, 0.0 };
+	gripper_response info;
+
+	while ( running_ )
+	{
+		command_box_.take( &cmd );
+
+		if ( !script_measure_move( SCRIPT_SPEED_CONTROL, 0.0, speedCommand( cmd ), info ) )
+		{
+			ROS_WARN_THROTTLE( 1.0, "WSG50 exchange failed, is cmd_vel_out.lua running?" );
+			std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+			continue;
+		}
+		if ( read_force_ ) getForce();
+	}
+
+	// Leave the fingers at rest
+	script_measure_move( SCRIPT_SPEED_CONTROL, 0.0, 0.0, info );
+}
+
+
+PLUGINLIB_EXPORT_CLASS( WSG50HW, hardware_interface::RobotHW )
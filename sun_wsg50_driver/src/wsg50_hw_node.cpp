@@ -0,0 +1,66 @@
+//======================================================================
+/**
+ *  @file
+ *  wsg50_hw_node.cpp
+ *
+ *  @section wsg50_hw_node.cpp_general General file information
+ *
+ *  @brief
+ *  Controller manager loop for the WSG50 hardware interface. To run the
+ *  gripper in the loop of an arm, load WSG50HW as a combined_robot_hw
+ *  plugin instead.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section wsg50_hw_node.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#include <ros/ros.h>
+#include <controller_manager/controller_manager.h>
+
+#include "wsg_50/wsg50_hw.h"
+
+
+int main( int argc, char **argv )
+{
+	ros::init( argc, argv, "wsg50_hw" );
+
+	ros::NodeHandle nh;
+	ros::NodeHandle nh_private( "~" );
+	double loop_hz;
+
+	nh_private.param( "loop_hz", loop_hz, 500.0 );
+
+	// Controller services are served outside the control loop
+	ros::AsyncSpinner spinner( 2 );
+	spinner.start();
+
+	WSG50HW hw;
+	if ( !hw.init( nh, nh_private ) ) return 1;
+
+	controller_manager::ControllerManager cm( &hw, nh );
+
+	ros::Rate rate( loop_hz );
+	ros::Time last = ros::Time::now();
+	while ( ros::ok() )
+	{
+		ros::Time now = ros::Time::now();
+		ros::Duration period = now - last;
+		last = now;
+
+		hw.read( now, period );
+		cm.update( now, period );
+		hw.write( now, period );
+
+		rate.sleep();
+	}
+
+	spinner.stop();
+	return 0;
+}
@@ -0,0 +1,231 @@
+//======================================================================
+/**
+ *  @file
+ *  wsg50_log_convert.cpp
+ *
+ *  @section wsg50_log_convert.cpp_general General file information
+ *
+ *  @brief
+ *  Offline converter for the driver's binary sample logs.
+ *
+ *  Reads a log written by SampleLog (see sample_log.h), also while the
+ *  driver is still writing it, and writes the records in append order
+ *  as CSV (one row per sample, the finger sensor values as 25 columns
+ *  each) and, when built with catkin, as a rosbag with
+ *  sun_wsg50_common/StatusCompact and sensor_msgs/JointState messages
+ *  stamped with the sampling instant.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section wsg50_log_convert.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+#include "wsg_50/sample_log.h"
+
+#ifdef WSG50_HAVE_ROSBAG
+#include <rosbag/bag.h>
+#include <sensor_msgs/JointState.h>
+#include "sun_wsg50_common/StatusCompact.h"
+#endif
+
+
+//------------------------------------------------------------------------
+// Function implementation
+//------------------------------------------------------------------------
+
+static int write_csv( FILE *out, const std::vector<sample_record> &records )
+{
+	fprintf( out, "index,stamp,received,seq,device_ms,state,flags,position,speed,force,force_finger0,force_finger1" );
+	for ( int f = 0; f < 2; f++ )
+		for ( int i = 0; i < 25; i++ )
+			fprintf( out, ",tactile%d_%d", f, i );
+	fprintf( out, "\n" );
+
+	for ( size_t k = 0; k < records.size(); k++ )
+	{
+		const sample_record &r = records[k];
+		fprintf( out, "%" PRIu64 ",%.6f,%.6f,%u,%u,%u,%u,%g,%g,%g,%g,%g",
+				 r.index, r.stamp, r.received, r.seq, r.device_ms, r.state, r.flags,
+				 r.position, r.speed, r.force, r.force_finger0, r.force_finger1 );
+		for ( int i = 0; i < 25; i++ ) fprintf( out, ",%g", r.tactile0[i] );
+		for ( int i = 0; i < 25; i++ ) fprintf( out, ",%g", r.tactile1[i] );
+		fprintf( out, "\n" );
+	}
+	return ferror( out ) ? -1 : 0;
+}
+
+
+#ifdef WSG50_HAVE_ROSBAG
+static int write_bag( const char *path, const std::string &ns, const std::string &joint,
+					  const std::vector<sample_record> &records )
+{
+	try
+	{
+		rosbag::Bag bag;
+		bag.open( path, rosbag::bagmode::Write );
+
+		sun_wsg50_common::StatusCompact status;
+		sensor_msgs::JointState joint_states;
+		joint_states.header.frame_id = "gripper_tool_frame";
+		joint_states.name.push_back( joint );
+		joint_states.position.resize( 1 );
+		joint_states.velocity.resize( 1 );
+		joint_states.effort.resize( 1 );
+
+		for ( size_t k = 0; k < records.size(); k++ )
+		{
+			const sample_record &r = records[k];
+			if ( r.stamp <= 0.0 ) continue;		// Not representable as ros::Time
+			ros::Time stamp( r.stamp );
+
+			status.header.seq = (uint32_t) r.index;
+			status.header.stamp = stamp;
+			status.state = r.state;
+			status.width = r.position;
+			status.speed = r.speed;
+			status.force = r.force;
+			status.force_finger0 = r.force_finger0;
+			status.force_finger1 = r.force_finger1;
+			bag.write( ns + "status_compact", stamp, status );
+
+			joint_states.header.seq = (uint32_t) r.index;
+			joint_states.header.stamp = stamp;
+			joint_states.position[0] = r.position / 1000.0;
+			joint_states.velocity[0] = r.speed / 1000.0;
+			joint_states.effort[0] = r.force;
+			bag.write( ns + "joint_states", stamp, joint_states );
+		}
+		bag.close();
+	}
+	catch ( const std::exception &e )
+	{
+		fprintf( stderr, "Writing %s failed: %s\n", path, e.what() );
+		return -1;
+	}
+	return 0;
+}
+#endif
+
+
+static void usage( const char *name )
+{
+	printf( "Usage: %s [options] LOG\n"
+			"  -c, --csv FILE                  Write CSV, - for stdout (default)\n"
+#ifdef WSG50_HAVE_ROSBAG
+			"  -b, --bag FILE                  Write a rosbag\n"
+			"  -n, --ns NS                     Namespace of the bag topics (default /)\n"
+			"  -j, --joint NAME                Joint name (default gripper_joint)\n"
+#endif
+			"  -i, --info                      Print the header and the record count only\n", name );
+}
+
+
+/**
+ * The main function
+ */
+
+int main( int argc, char **argv )
+{
+	std::string csv, bag, ns = "/", joint = "gripper_joint";
+	bool info = false;
+	int c;
+
+	static const struct option long_options[] =
+	{
+		{ "csv", required_argument, 0, 'c' },
+		{ "bag", required_argument, 0, 'b' },
+		{ "ns", required_argument, 0, 'n' },
+		{ "joint", required_argument, 0, 'j' },
+		{ "info", no_argument, 0, 'i' },
+		{ "help", no_argument, 0, 'h' },
+		{ 0, 0, 0, 0 }
+	};
+
+	while ( ( c = getopt_long( argc, argv, "c:b:n:j:ih", long_options, NULL ) ) != -1 )
+	{
+		switch ( c )
+		{
+			case 'c': csv = optarg; break;
+			case 'b': bag = optarg; break;
+			case 'n': ns = optarg; break;
+			case 'j': joint = optarg; break;
+			case 'i': info = true; break;
+			case 'h': usage( argv[0] ); return 0;
+			default: usage( argv[0] ); return 1;
+		}
+	}
+	if ( optind != argc - 1 )
+	{
+		usage( argv[0] );
+		return 1;
+	}
+#ifndef WSG50_HAVE_ROSBAG
+	if ( !bag.empty() )
+	{
+		fprintf( stderr, "Built without rosbag support\n" );
+		return 1;
+	}
+#endif
+	if ( ns.empty() || ns[ns.size() - 1] != '/' ) ns += "/";
+	if ( csv.empty() && bag.empty() ) csv = "-";
+
+	sample_log_header header;
+	std::vector<sample_record> records;
+	if ( sample_log_read( argv[optind], &header, records ) != 0 )
+	{
+		fprintf( stderr, "%s: not a readable sample log\n", argv[optind] );
+		return 1;
+	}
+
+	uint64_t lost = header.count > records.size() ? header.count - records.size() : 0;
+	if ( info )
+	{
+		printf( "capacity %" PRIu64 ", appended %" PRIu64 ", kept %zu, overwritten or incomplete %" PRIu64 "\n",
+				header.capacity, header.count, records.size(), lost );
+		return 0;
+	}
+	if ( lost > 0 )
+		fprintf( stderr, "%" PRIu64 " of %" PRIu64 " records overwritten or incomplete\n", lost, header.count );
+
+	if ( !csv.empty() )
+	{
+		FILE *out = csv == "-" ? stdout : fopen( csv.c_str(), "w" );
+		if ( !out )
+		{
+			perror( csv.c_str() );
+			return 1;
+		}
+		int res = write_csv( out, records );
+		if ( out != stdout && fclose( out ) != 0 ) res = -1;
+		if ( res != 0 )
+		{
+			fprintf( stderr, "Writing %s failed\n", csv.c_str() );
+			return 1;
+		}
+	}
+
+#ifdef WSG50_HAVE_ROSBAG
+	if ( !bag.empty() && write_bag( bag.c_str(), ns, joint, records ) != 0 )
+		return 1;
+#endif
+
+	return 0;
+}
@@ -0,0 +1,70 @@
+//======================================================================
+/**
+ *  @file
+ *  wsg50_nodelet.cpp
+ *
+ *  @section wsg50_nodelet.cpp_general General file information
+ *
+ *  @brief
+ *  Nodelet version of the WSG50 driver. Loaded into the same manager as
+ *  the control nodelets, width and goal_speed are passed by pointer.
+ *
+ *  Connection and homing take seconds, so driver_start() runs in its own
+ *  thread instead of blocking the manager in onInit(). The callbacks
+ *  use the single-threaded queue of the nodelet, in streaming mode the
+ *  multi-threaded one, as in the node.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section wsg50_nodelet.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+#include <thread>
+
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_list_macros.h>
+
+#include "wsg_50/driver.h"
+
+
+namespace sun_wsg50_driver
+{
+
+class DriverNodelet : public nodelet::Nodelet
+{
+public:
+	DriverNodelet() : started_( false ) {}
+
+	virtual ~DriverNodelet()
+	{
+		if ( start_thread_.joinable() ) start_thread_.join();
+		if ( started_ ) driver_stop();
+	}
+
+private:
+	virtual void onInit()
+	{
+		start_thread_ = std::thread( [this]
+		{
+			if ( driver_concurrent( getPrivateNodeHandle() ) )
+				started_ = driver_start( getMTPrivateNodeHandle(), getMTNodeHandle() );
+			else
+				started_ = driver_start( getPrivateNodeHandle(), getNodeHandle() );
+			if ( !started_ ) NODELET_ERROR( "WSG50 driver not started" );
+		} );
+	}
+
+	std::thread start_thread_;
+	bool started_;
+};
+
+}
+
+
+PLUGINLIB_EXPORT_CLASS( sun_wsg50_driver::DriverNodelet, nodelet::Nodelet )
@@ -0,0 +1,168 @@
+//======================================================================
+/**
+ *  @file
+ *  contact_detector_test.cpp
+ *
+ *  @section contact_detector_test.cpp_general General file information
+ *
+ *  @brief
+ *  Unit tests of the contact detection of speed commands: the motor
+ *  force rise detects together with the speed collapse, at once, while
+ *  the collapse alone needs collapse_time; unmeasured forces, the arm
+ *  time and disabled thresholds never detect.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section contact_detector_test.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+
+#include <gtest/gtest.h>
+
+#include "wsg_50/contact_detector.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define DT					0.01	// Sampling period [s]
+#define COMMAND				-20.0	// Closing speed command [mm/s]
+#define FREE_FORCE			2.0		// Motor force of the free motion [N]
+
+
+//------------------------------------------------------------------------
+// Support functions
+//------------------------------------------------------------------------
+
+/**
+ * Free motion at the commanded speed until time end, past the arm time
+ *
+ * @return Sources reported by any of the samples
+ */
+
+static unsigned int free_motion( ContactDetector &detector, double *time, double end, double force = FREE_FORCE )
+{
+	unsigned int sources = 0;
+
+	for ( ; *time < end; *time += DT )
+		sources |= detector.update( *time, COMMAND, COMMAND, force, NAN );
+	return sources;
+}
+
+
+//------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------
+
+TEST( ContactDetector, ForceRiseWithCollapseDetectsAtOnce )
+{
+	ContactDetector detector;
+	double time = 0.0;
+
+	EXPECT_EQ( free_motion( detector, &time, 0.3 ), 0u );
+
+	// First collapsed sample: no need to wait for collapse_time
+	EXPECT_EQ( detector.update( time, COMMAND, -1.0, FREE_FORCE + 10.0, NAN ), (unsigned int)( CONTACT_FORCE | CONTACT_SPEED ) );
+}
+
+
+TEST( ContactDetector, ForceRiseWithoutCollapseIgnored )
+{
+	ContactDetector detector;
+	double time = 0.0;
+
+	EXPECT_EQ( free_motion( detector, &time, 0.3 ), 0u );
+
+	// Friction peak at full speed: no contact, and not taken into the baseline
+	EXPECT_EQ( free_motion( detector, &time, 0.4, FREE_FORCE + 10.0 ), 0u );
+	EXPECT_EQ( detector.update( time, COMMAND, -1.0, FREE_FORCE + 10.0, NAN ), (unsigned int)( CONTACT_FORCE | CONTACT_SPEED ) );
+}
+
+
+TEST( ContactDetector, BaselineFollowsFreeMotion )
+{
+	ContactDetector detector;
+	double time = 0.0;
+
+	// The free motion force drifts slowly, the rise is measured from its level
+	for ( double force = FREE_FORCE; time < 1.0; time += DT, force += 0.05 )
+		EXPECT_EQ( detector.update( time, COMMAND, COMMAND, force, NAN ), 0u ) << "at " << time << " s";
+
+	double level = FREE_FORCE + 100 * 0.05;
+	EXPECT_EQ( detector.update( time, COMMAND, -1.0, level + 3.0, NAN ), 0u );
+	EXPECT_EQ( detector.update( time + DT, COMMAND, -1.0, level + 8.0, NAN ), (unsigned int)( CONTACT_FORCE | CONTACT_SPEED ) );
+}
+
+
+TEST( ContactDetector, CollapseAloneNeedsCollapseTime )
+{
+	ContactDetector detector;
+	double time = 0.0;
+
+	EXPECT_EQ( free_motion( detector, &time, 0.3, NAN ), 0u );
+
+	// No motor force: the collapse has to last collapse_time (0.03 s)
+	EXPECT_EQ( detector.update( time, COMMAND, -1.0, NAN, NAN ), 0u );
+	EXPECT_EQ( detector.update( time + 0.02, COMMAND, -1.0, NAN, NAN ), 0u );
+	EXPECT_EQ( detector.update( time + 0.04, COMMAND, -1.0, NAN, NAN ), (unsigned int) CONTACT_SPEED );
+}
+
+
+TEST( ContactDetector, ForceThresholdZeroDisables )
+{
+	ContactDetector detector;
+	contact_params params = detector.params();
+	double time = 0.0;
+
+	params.force_threshold = 0.0;
+	detector.set_params( params );
+	EXPECT_EQ( free_motion( detector, &time, 0.3 ), 0u );
+	EXPECT_EQ( detector.update( time, COMMAND, -1.0, FREE_FORCE + 10.0, NAN ), 0u );
+	EXPECT_EQ( detector.update( time + 0.04, COMMAND, -1.0, FREE_FORCE + 10.0, NAN ), (unsigned int) CONTACT_SPEED );
+}
+
+
+TEST( ContactDetector, ArmTimeIgnored )
+{
+	ContactDetector detector;
+
+	// Accelerating fingers: slow, with the force of the acceleration
+	EXPECT_EQ( detector.update( 0.0, COMMAND, 0.0, FREE_FORCE, NAN ), 0u );
+	EXPECT_EQ( detector.update( 0.05, COMMAND, -1.0, FREE_FORCE + 10.0, 5.0 ), 0u );
+	EXPECT_EQ( detector.update( 0.09, COMMAND, -1.0, FREE_FORCE + 10.0, 5.0 ), 0u );
+}
+
+
+TEST( ContactDetector, FingerForce )
+{
+	ContactDetector detector;
+	double time = 0.0;
+
+	EXPECT_EQ( free_motion( detector, &time, 0.3 ), 0u );
+	EXPECT_EQ( detector.update( time, COMMAND, COMMAND, FREE_FORCE, 1.0 ), 0u );
+	EXPECT_EQ( detector.update( time + DT, COMMAND, COMMAND, FREE_FORCE, -2.5 ), (unsigned int) CONTACT_FINGER );
+}
+
+
+TEST( ContactDetector, OpeningAndSlowCommandsNotWatched )
+{
+	ContactDetector detector;
+
+	for ( double time = 0.0; time < 0.5; time += DT )
+	{
+		EXPECT_EQ( detector.update( time, -COMMAND, 0.0, FREE_FORCE + 10.0, 5.0 ), 0u );
+		EXPECT_EQ( detector.update( time, -1.0, 0.0, FREE_FORCE + 10.0, 5.0 ), 0u );
+	}
+}
@@ -0,0 +1,222 @@
+//======================================================================
+/**
+ *  @file
+ *  dispatch_test.cpp
+ *
+ *  @section dispatch_test.cpp_general General file information
+ *
+ *  @brief
+ *  Unit tests of the response dispatcher of the streaming mode, over a
+ *  simulated gripper interface: a STOP completes while a blocking MOVE
+ *  waits for its final response, as the stop service does while a move
+ *  service or action is running in another callback thread.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section dispatch_test.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "wsg_50/common.h"
+#include "wsg_50/checksum.h"
+#include "wsg_50/cmd.h"
+#include "wsg_50/dispatch.h"
+#include "wsg_50/functions.h"
+#include "wsg_50/msg.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define ID_MOVE				0x21
+#define ID_STOP				0x22
+#define RESPONSE_TIMEOUT	2.0		// [s]
+#define WAIT				std::chrono::seconds( 1 )
+
+
+//------------------------------------------------------------------------
+// Simulated gripper
+//------------------------------------------------------------------------
+
+static std::mutex rx_mutex;
+static std::condition_variable rx_cond;
+static std::deque<unsigned char> rx;
+static bool rx_closed = false;
+static std::atomic<int> moves_sent( 0 ), stops_sent( 0 );
+
+
+/** \brief Queue a response frame with a status-only payload */
+static void respond( unsigned char id, status_t status )
+{
+	unsigned char frame[10] = { 0xAA, 0xAA, 0xAA, id, 2, 0,
+								(unsigned char)( status & 0xff ), (unsigned char)( status >> 8 ) };
+	unsigned short crc = checksum_crc16( frame, 8 );
+
+	frame[8] = crc & 0xff;
+	frame[9] = crc >> 8;
+	std::lock_guard<std::mutex> lock( rx_mutex );
+	rx.insert( rx.end(), frame, frame + sizeof( frame ) );
+	rx_cond.notify_all();
+}
+
+
+static int sim_open( const void *params ) { return 0; }
+static void sim_close( void ) {}
+
+
+/** \brief Blocks like a socket until a response is queued, -1 once closed */
+static int sim_read( unsigned char *buf, unsigned int len )
+{
+	std::unique_lock<std::mutex> lock( rx_mutex );
+	unsigned int n = 0;
+
+	rx_cond.wait( lock, [] { return !rx.empty() || rx_closed; } );
+	if ( rx.empty() ) return -1;
+	while ( n < len && !rx.empty() )
+	{
+		buf[n++] = rx.front();
+		rx.pop_front();
+	}
+	return n;
+}
+
+
+/**
+ * MOVE is acknowledged as pending and only ends when the test says so,
+ * any other command succeeds at once. The command ID is the byte after
+ * the preamble.
+ */
+
+static int sim_write( unsigned char *buf, unsigned int len )
+{
+	if ( buf[3] == ID_MOVE )
+	{
+		respond( ID_MOVE, E_CMD_PENDING );
+		moves_sent++;
+	}
+	else
+	{
+		respond( buf[3], E_SUCCESS );
+		if ( buf[3] == ID_STOP ) stops_sent++;
+	}
+	return len;
+}
+
+
+static const interface_t sim_interface = { "sim", sim_open, sim_close, sim_read, sim_write };
+
+
+//------------------------------------------------------------------------
+// Support functions
+//------------------------------------------------------------------------
+
+/** \brief Connected simulated gripper with the reader thread of the streaming mode */
+class DispatchTest : public ::testing::Test
+{
+protected:
+	virtual void SetUp()
+	{
+		rx.clear();
+		rx_closed = false;
+		moves_sent = stops_sent = 0;
+		ASSERT_EQ( cmd_connect_interface( &sim_interface, NULL ), 0 );
+		dispatch_enable( RESPONSE_TIMEOUT );
+		reader_ = std::thread( []
+		{
+			msg_t msg;
+			while ( msg_receive( &msg ) >= 0 )
+			{
+				dispatch_deliver( &msg );
+				msg_free( &msg );
+			}
+		} );
+	}
+
+	virtual void TearDown()
+	{
+		cmd_disconnect();
+		{
+			std::lock_guard<std::mutex> lock( rx_mutex );
+			rx_closed = true;
+			rx_cond.notify_all();
+		}
+		reader_.join();
+		dispatch_disable();
+	}
+
+	std::thread reader_;
+};
+
+
+//------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------
+
+TEST_F( DispatchTest, StopCompletesDuringBlockingMove )
+{
+	std::future<status_t> moving = std::async( std::launch::async, []
+	{
+		move( 50.0, 20.0, false );
+		return command_status();
+	} );
+
+	auto start = std::chrono::steady_clock::now();
+	while ( moves_sent == 0 && std::chrono::steady_clock::now() - start < WAIT )
+		std::this_thread::yield();
+	ASSERT_EQ( moves_sent, 1 );
+
+	// The stop service, while the move service waits for the end of the motion
+	std::future<int> stopping = std::async( std::launch::async, [] { return stop(); } );
+	ASSERT_EQ( stopping.wait_for( WAIT ), std::future_status::ready );
+	EXPECT_EQ( stopping.get(), 0 );
+	EXPECT_EQ( stops_sent, 1 );
+	EXPECT_EQ( moving.wait_for( std::chrono::milliseconds( 0 ) ), std::future_status::timeout );
+
+	// The gripper ends the stopped motion
+	respond( ID_MOVE, E_CMD_ABORTED );
+	ASSERT_EQ( moving.wait_for( WAIT ), std::future_status::ready );
+	EXPECT_EQ( moving.get(), E_CMD_ABORTED );
+}
+
+
+TEST_F( DispatchTest, SendOnlyStopDuringBlockingMove )
+{
+	std::future<status_t> moving = std::async( std::launch::async, []
+	{
+		move( 50.0, 20.0, false );
+		return command_status();
+	} );
+
+	auto start = std::chrono::steady_clock::now();
+	while ( moves_sent == 0 && std::chrono::steady_clock::now() - start < WAIT )
+		std::this_thread::yield();
+	ASSERT_EQ( moves_sent, 1 );
+
+	// The STOP of a preempted action: sent without waiting, its response is dropped
+	EXPECT_EQ( stop( true ), 0 );
+	EXPECT_EQ( stops_sent, 1 );
+
+	respond( ID_MOVE, E_CMD_ABORTED );
+	ASSERT_EQ( moving.wait_for( WAIT ), std::future_status::ready );
+	EXPECT_EQ( moving.get(), E_CMD_ABORTED );
+}
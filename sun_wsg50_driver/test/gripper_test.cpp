@@ -0,0 +1,338 @@
+//======================================================================
+/**
+ *  @file
+ *  gripper_test.cpp
+ *
+ *  @section gripper_test.cpp_general General file information
+ *
+ *  @brief
+ *  Unit tests of the framing of Gripper<Transport> (gripper.h) over the
+ *  in-memory SimTransport: frame layout and checksum, resync after
+ *  garbage, checksum errors, frames split in pieces or cut short and
+ *  the pending status loop of submit(). The TCP and UDP transports are
+ *  run against a peer socket on the loopback interface.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section gripper_test.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <string.h>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <gtest/gtest.h>
+
+#include "wsg_50/gripper.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define ID_MOVE				0x21
+#define ID_OPENING			0x43
+
+
+//------------------------------------------------------------------------
+// Support functions
+//------------------------------------------------------------------------
+
+/** \brief Complete frame: preamble, id, length, payload, CRC */
+static std::vector<unsigned char> frame( unsigned char id, const std::vector<unsigned char> &payload )
+{
+	std::vector<unsigned char> f( GRIPPER_HEADER_LEN + payload.size() + 2, MSG_PREAMBLE_BYTE );
+	unsigned short crc;
+
+	f[MSG_PREAMBLE_LEN] = id;
+	f[MSG_PREAMBLE_LEN + 1] = lo( payload.size() );
+	f[MSG_PREAMBLE_LEN + 2] = hi( payload.size() );
+	if ( !payload.empty() ) memcpy( &f[GRIPPER_HEADER_LEN], &payload[0], payload.size() );
+
+	crc = checksum_crc16( &f[0], GRIPPER_HEADER_LEN + payload.size() );
+	f[GRIPPER_HEADER_LEN + payload.size()] = lo( crc );
+	f[GRIPPER_HEADER_LEN + payload.size() + 1] = hi( crc );
+	return f;
+}
+
+
+/** \brief Response frame carrying only a status code */
+static std::vector<unsigned char> status_frame( unsigned char id, status_t status )
+{
+	return frame( id, { lo( status ), hi( status ) } );
+}
+
+
+static void feed( SimGripper &gripper, const std::vector<unsigned char> &bytes )
+{
+	gripper.transport().feed( &bytes[0], (unsigned int) bytes.size() );
+}
+
+
+/** \brief SimTransport handing out at most chunk bytes per read, as a slow serial line */
+template <unsigned int chunk>
+class ChunkTransport : public SimTransport
+{
+public:
+	int read( unsigned char *buf, unsigned int len )
+	{
+		return SimTransport::read( buf, len < chunk ? len : chunk );
+	}
+};
+
+
+/** \brief Loopback socket of the given type, bound to an ephemeral port */
+static int loopback_socket( int type, unsigned short *port )
+{
+	struct sockaddr_in addr;
+	socklen_t len = sizeof( addr );
+	int sock = socket( PF_INET, type, 0 );
+
+	memset( &addr, 0, sizeof( addr ) );
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+	addr.sin_port = 0;
+	if ( sock < 0 || bind( sock, (struct sockaddr *) &addr, sizeof( addr ) ) < 0 ||
+		 getsockname( sock, (struct sockaddr *) &addr, &len ) < 0 )
+	{
+		if ( sock >= 0 ) close( sock );
+		return -1;
+	}
+	*port = ntohs( addr.sin_port );
+	return sock;
+}
+
+
+//------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------
+
+TEST( GripperFraming, SendLayoutAndChecksum )
+{
+	SimGripper gripper;
+	const unsigned char payload[] = { 0x00, 0x01, 0x02, 0xaa };
+
+	EXPECT_EQ( gripper.send( ID_MOVE, payload, sizeof( payload ) ), (int)( GRIPPER_HEADER_LEN + sizeof( payload ) + 2 ) );
+	EXPECT_EQ( gripper.transport().written(), frame( ID_MOVE, { 0x00, 0x01, 0x02, 0xaa } ) );
+
+	// The checksum over the whole frame, CRC included, is zero
+	const std::vector<unsigned char> &sent = gripper.transport().written();
+	EXPECT_EQ( checksum_crc16( (unsigned char *) &sent[0], sent.size() ), 0 );
+}
+
+
+TEST( GripperFraming, ReceiveFrame )
+{
+	SimGripper gripper;
+	msg_t msg;
+
+	feed( gripper, frame( ID_OPENING, { 1, 2, 3, 4, 5, 6 } ) );
+	ASSERT_EQ( gripper.receive( &msg ), 6 + 8 );
+	EXPECT_EQ( msg.id, ID_OPENING );
+	ASSERT_EQ( msg.len, 6u );
+	EXPECT_EQ( msg.data[0], 1 );
+	EXPECT_EQ( msg.data[5], 6 );
+	EXPECT_EQ( gripper.crc_errors(), 0ul );
+	EXPECT_GT( gripper.received_at(), 0.0 );
+}
+
+
+TEST( GripperFraming, ResyncAfterGarbage )
+{
+	SimGripper gripper;
+	msg_t msg;
+
+	// Noise, then a broken preamble (two 0xaa), then the frame
+	feed( gripper, { 0x00, 0x13, 0xaa, 0x7f, 0xaa, 0xaa, 0x21 } );
+	feed( gripper, frame( ID_OPENING, { 9, 8, 7, 6 } ) );
+	ASSERT_EQ( gripper.receive( &msg ), 4 + 8 );
+	EXPECT_EQ( msg.id, ID_OPENING );
+	EXPECT_EQ( msg.data[0], 9 );
+	EXPECT_EQ( gripper.crc_errors(), 0ul );
+}
+
+
+TEST( GripperFraming, ChecksumErrorDropsFrame )
+{
+	SimGripper gripper;
+	std::vector<unsigned char> bad = frame( ID_OPENING, { 1, 2, 3, 4 } );
+	msg_t msg;
+
+	bad[GRIPPER_HEADER_LEN + 1] ^= 0x10;
+	feed( gripper, bad );
+	feed( gripper, frame( ID_OPENING, { 5, 6, 7, 8 } ) );
+
+	EXPECT_EQ( gripper.receive( &msg ), -1 );
+	EXPECT_EQ( gripper.crc_errors(), 1ul );
+
+	// The stream stays usable: the next frame is received
+	ASSERT_EQ( gripper.receive( &msg ), 4 + 8 );
+	EXPECT_EQ( msg.data[0], 5 );
+	EXPECT_EQ( gripper.crc_errors(), 1ul );
+}
+
+
+TEST( GripperFraming, FrameInPieces )
+{
+	Gripper< ChunkTransport<1> > bytewise;
+	Gripper< ChunkTransport<5> > chunked;
+	std::vector<unsigned char> f = frame( ID_OPENING, { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 } );
+	msg_t msg;
+
+	bytewise.transport().feed( &f[0], (unsigned int) f.size() );
+	ASSERT_EQ( bytewise.receive( &msg ), 13 + 8 );
+	EXPECT_EQ( msg.data[12], 13 );
+
+	chunked.transport().feed( &f[0], (unsigned int) f.size() );
+	ASSERT_EQ( chunked.receive( &msg ), 13 + 8 );
+	EXPECT_EQ( msg.data[12], 13 );
+}
+
+
+TEST( GripperFraming, PartialFrameFails )
+{
+	SimGripper gripper;
+	std::vector<unsigned char> f = frame( ID_OPENING, { 1, 2, 3, 4 } );
+	msg_t msg;
+
+	// The connection ends within the payload, and within the header
+	f.resize( f.size() - 3 );
+	feed( gripper, f );
+	EXPECT_EQ( gripper.receive( &msg ), -1 );
+	EXPECT_EQ( gripper.crc_errors(), 0ul );
+
+	gripper.transport().clear();
+	feed( gripper, { 0xaa, 0xaa, 0xaa, ID_OPENING } );
+	EXPECT_EQ( gripper.receive( &msg ), -1 );
+}
+
+
+TEST( GripperSubmit, WaitsWhilePending )
+{
+	SimGripper gripper;
+	const unsigned char payload[] = { 0x00 };
+	unsigned char *resp;
+	unsigned int resp_len;
+
+	feed( gripper, status_frame( ID_MOVE, E_CMD_PENDING ) );
+	feed( gripper, status_frame( ID_MOVE, E_CMD_PENDING ) );
+	feed( gripper, status_frame( ID_MOVE, E_SUCCESS ) );
+
+	ASSERT_EQ( gripper.submit( ID_MOVE, payload, sizeof( payload ), true, &resp, &resp_len ), 2 );
+	ASSERT_EQ( resp_len, 2u );
+	EXPECT_EQ( make_short( resp[0], resp[1] ), E_SUCCESS );
+	EXPECT_EQ( gripper.transport().written(), frame( ID_MOVE, { 0x00 } ) );
+}
+
+
+TEST( GripperSubmit, PendingIsFinalWithoutFlag )
+{
+	SimGripper gripper;
+	unsigned char *resp;
+	unsigned int resp_len;
+
+	feed( gripper, status_frame( ID_MOVE, E_CMD_PENDING ) );
+	ASSERT_EQ( gripper.submit( ID_MOVE, NULL, 0, false, &resp, &resp_len ), 2 );
+	EXPECT_EQ( make_short( resp[0], resp[1] ), E_CMD_PENDING );
+}
+
+
+TEST( GripperSubmit, RejectsOtherResponses )
+{
+	SimGripper gripper;
+	unsigned char *resp;
+	unsigned int resp_len;
+
+	// Response to another command
+	feed( gripper, status_frame( ID_OPENING, E_SUCCESS ) );
+	EXPECT_EQ( gripper.submit( ID_MOVE, NULL, 0, true, &resp, &resp_len ), -1 );
+
+	// No status code in a pending response
+	gripper.transport().clear();
+	feed( gripper, frame( ID_MOVE, { 0x1a } ) );
+	EXPECT_EQ( gripper.submit( ID_MOVE, NULL, 0, true, &resp, &resp_len ), -1 );
+
+	// Nothing after the pending status
+	gripper.transport().clear();
+	feed( gripper, status_frame( ID_MOVE, E_CMD_PENDING ) );
+	EXPECT_EQ( gripper.submit( ID_MOVE, NULL, 0, true, &resp, &resp_len ), -1 );
+}
+
+
+TEST( GripperTransport, TcpLoopback )
+{
+	unsigned short port;
+	int server = loopback_socket( SOCK_STREAM, &port );
+	ASSERT_GE( server, 0 );
+	ASSERT_EQ( listen( server, 1 ), 0 );
+
+	TcpGripper gripper;
+	ASSERT_EQ( gripper.transport().open( "127.0.0.1", port ), 0 );
+	int peer = accept( server, NULL, NULL );
+	ASSERT_GE( peer, 0 );
+
+	const unsigned char payload[] = { 0x01, 0x02 };
+	ASSERT_EQ( gripper.send( ID_MOVE, payload, sizeof( payload ) ), (int)( GRIPPER_HEADER_LEN + 2 + 2 ) );
+	std::vector<unsigned char> expected = frame( ID_MOVE, { 0x01, 0x02 } ), got( expected.size() );
+	ASSERT_EQ( recv( peer, &got[0], got.size(), MSG_WAITALL ), (ssize_t) got.size() );
+	EXPECT_EQ( got, expected );
+
+	std::vector<unsigned char> response = status_frame( ID_MOVE, E_SUCCESS );
+	ASSERT_EQ( send( peer, &response[0], response.size(), 0 ), (ssize_t) response.size() );
+	msg_t msg;
+	ASSERT_EQ( gripper.receive( &msg ), 2 + 8 );
+	EXPECT_EQ( msg.id, ID_MOVE );
+	EXPECT_EQ( make_short( msg.data[0], msg.data[1] ), E_SUCCESS );
+
+	gripper.close();
+	close( peer );
+	close( server );
+}
+
+
+TEST( GripperTransport, UdpLoopback )
+{
+	unsigned short port;
+	int server = loopback_socket( SOCK_DGRAM, &port );
+	ASSERT_GE( server, 0 );
+
+	UdpGripper gripper;
+	ASSERT_EQ( gripper.transport().open( 0, "127.0.0.1", port ), 0 );
+
+	const unsigned char payload[] = { 0x01, 0x02 };
+	ASSERT_GT( gripper.send( ID_MOVE, payload, sizeof( payload ) ), 0 );
+	std::vector<unsigned char> expected = frame( ID_MOVE, { 0x01, 0x02 } ), got( 64 );
+	struct sockaddr_in from;
+	socklen_t from_len = sizeof( from );
+	ssize_t n = recvfrom( server, &got[0], got.size(), 0, (struct sockaddr *) &from, &from_len );
+	ASSERT_EQ( n, (ssize_t) expected.size() );
+	got.resize( n );
+	EXPECT_EQ( got, expected );
+
+	// One datagram holding a pending and a final response
+	std::vector<unsigned char> response = status_frame( ID_MOVE, E_CMD_PENDING ), done = status_frame( ID_MOVE, E_SUCCESS );
+	response.insert( response.end(), done.begin(), done.end() );
+	ASSERT_EQ( sendto( server, &response[0], response.size(), 0, (struct sockaddr *) &from, from_len ), (ssize_t) response.size() );
+	msg_t msg;
+	ASSERT_EQ( gripper.receive( &msg ), 2 + 8 );
+	EXPECT_EQ( make_short( msg.data[0], msg.data[1] ), E_CMD_PENDING );
+	ASSERT_EQ( gripper.receive( &msg ), 2 + 8 );
+	EXPECT_EQ( make_short( msg.data[0], msg.data[1] ), E_SUCCESS );
+
+	gripper.close();
+	close( server );
+}
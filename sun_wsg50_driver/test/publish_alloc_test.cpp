@@ -0,0 +1,202 @@
+//======================================================================
+/**
+ *  @file
+ *  publish_alloc_test.cpp
+ *
+ *  @section publish_alloc_test.cpp_general General file information
+ *
+ *  @brief
+ *  Heap allocations of the timer_cb() publish path: the real messages
+ *  in ReusedMessage, prepared and filled by the driver_msgs.h functions
+ *  timer_cb() uses. After the first cycle no cycle may allocate.
+ *
+ *  Needs the ROS messages, built with catkin only.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section publish_alloc_test.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "wsg_50/msg_reuse.h"
+#include "wsg_50/driver_msgs.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define CYCLES				10000
+
+
+//------------------------------------------------------------------------
+// Allocation counter
+//------------------------------------------------------------------------
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( size_t size )
+{
+	void *p = malloc( size ? size : 1 );
+
+	if ( !p ) throw std::bad_alloc();
+	allocations++;
+	return p;
+}
+
+void operator delete( void *p ) noexcept
+{
+	free( p );
+}
+
+
+//------------------------------------------------------------------------
+// Support functions
+//------------------------------------------------------------------------
+
+/** \brief The messages of timer_cb(), prepared as in driver_start() */
+struct publish_msgs
+{
+	publish_msgs()
+		: joint( []( sensor_msgs::JointState &msg ) { init_joint_state( msg, "left_" ); } ),
+		  tactile( init_tactile ), pressure( init_tactile_pressure ) {}
+
+	ReusedMessage<sun_wsg50_common::StatusPtr> status;
+	ReusedMessage<sun_wsg50_common::StatusCompactPtr> compact;
+	ReusedMessage<sun_ros_msgs::Float64StampedPtr> width;
+	ReusedMessage<sensor_msgs::JointStatePtr> joint;
+	ReusedMessage<sun_wsg50_common::TactilePtr> tactile;
+	ReusedMessage<sun_wsg50_common::TactilePressurePtr> pressure;
+};
+
+
+/**
+ * One publish cycle with sample values of cycle n. The state text
+ * changes as in the driver: only with the state, between known texts.
+ */
+
+static void publish_cycle( publish_msgs &msgs, int n )
+{
+	static const std::string texts[2] = { "| Fingers Referenced |",
+										  "| Fingers Referenced | The Fingers are currently moving |" };
+	gripper_response info;
+	tactile_map maps[2];
+	bool calibrated[2] = { n % 3 != 0, n % 5 != 0 };
+	ros::Time stamp( 1000.0 + n * 0.002 );
+
+	memset( &info, 0, sizeof( info ) );
+	info.position = 40.0f + ( n % 100 ) * 0.1f;
+	info.speed = ( n % 2 ) ? 10.0f : -10.0f;
+	info.f_motor = 5.0f;
+	info.tact_finger0 = n % 2 == 0;
+	info.tact_finger1 = n % 7 != 0;
+	for ( int i = 0; i < TACTILE_TAXELS; i++ )
+	{
+		info.v_finger0[i] = info.v_finger1[i] = ( ( n + i ) % 33 ) * 0.1f;
+		maps[0].pressure[i] = maps[1].pressure[i] = i * 1.5f;
+	}
+	maps[0].force = maps[1].force = 2.0f;
+	maps[0].cop_x = maps[1].cop_x = 0.5f;
+	maps[0].cop_y = maps[1].cop_y = -0.5f;
+
+	fill_status( *msgs.status.get(), stamp, texts[( n / 50 ) % 2], info, 100.0f );
+	fill_status_compact( *msgs.compact.get(), stamp, ( n / 50 ) % 2 ? 3 : 1, info, 100.0f );
+	fill_width( *msgs.width.get(), stamp, info );
+	fill_joint_state( *msgs.joint.get(), stamp, info );
+	fill_tactile( *msgs.tactile.get(), stamp, info );
+	fill_tactile_pressure( *msgs.pressure.get(), stamp, maps, calibrated );
+}
+
+
+//------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------
+
+TEST( PublishAllocations, NoneAfterWarmUp )
+{
+	publish_msgs msgs;
+
+	// Warm-up: allocates the messages, the status text grows to the longest
+	for ( int n = 0; n < 100; n++ ) publish_cycle( msgs, n );
+
+	unsigned long start = allocations;
+	for ( int n = 100; n < 100 + CYCLES; n++ ) publish_cycle( msgs, n );
+	unsigned long cycle_allocations = allocations - start;
+
+	EXPECT_EQ( cycle_allocations, 0ul ) << "in " << CYCLES << " publish cycles";
+	EXPECT_EQ( msgs.status.allocations(), 1ul );
+	EXPECT_EQ( msgs.compact.allocations(), 1ul );
+	EXPECT_EQ( msgs.width.allocations(), 1ul );
+	EXPECT_EQ( msgs.joint.allocations(), 1ul );
+	EXPECT_EQ( msgs.tactile.allocations(), 1ul );
+	EXPECT_EQ( msgs.pressure.allocations(), 1ul );
+}
+
+
+TEST( PublishAllocations, FilledValues )
+{
+	publish_msgs msgs;
+
+	publish_cycle( msgs, 14 );		// Both fingers calibrated, tactile data of finger 0 only
+	const sensor_msgs::JointState &joint = *msgs.joint.get();
+	ASSERT_EQ( joint.name.size(), 1u );
+	EXPECT_EQ( joint.name[0], "left_gripper_joint" );
+	EXPECT_EQ( joint.header.frame_id, GRIPPER_FRAME_ID );
+	EXPECT_DOUBLE_EQ( joint.position[0], ( 40.0f + 14 * 0.1f ) / 1000.0 );
+	EXPECT_DOUBLE_EQ( msgs.width.get()->data, ( 40.0f + 14 * 0.1f ) / 1000.0 );
+
+	const sun_wsg50_common::Tactile &tactile = *msgs.tactile.get();
+	EXPECT_EQ( tactile.fingers, sun_wsg50_common::Tactile::FINGER0 );
+	EXPECT_EQ( tactile.rows, TACTILE_ROWS );
+	EXPECT_FLOAT_EQ( tactile.voltages[1], 1.5f );
+	EXPECT_EQ( tactile.voltages[TACTILE_TAXELS], 0.0f );
+
+	const sun_wsg50_common::TactilePressure &pressure = *msgs.pressure.get();
+	EXPECT_EQ( pressure.fingers, sun_wsg50_common::TactilePressure::FINGER0 | sun_wsg50_common::TactilePressure::FINGER1 );
+	EXPECT_FLOAT_EQ( pressure.grasp_force, 2.0f );
+
+	publish_cycle( msgs, 21 );		// Finger 0 not calibrated
+	EXPECT_EQ( msgs.pressure.get()->fingers, sun_wsg50_common::TactilePressure::FINGER1 );
+	EXPECT_EQ( msgs.pressure.get()->force[0], 0.0f );
+	EXPECT_TRUE( isnan( msgs.pressure.get()->cop_x[0] ) );
+	EXPECT_EQ( msgs.pressure.get()->pressure[TACTILE_TAXELS - 1], 0.0f );
+	EXPECT_FLOAT_EQ( msgs.pressure.get()->grasp_force, 2.0f );
+}
+
+
+TEST( PublishAllocations, HeldMessageIsNotReused )
+{
+	publish_msgs msgs;
+
+	publish_cycle( msgs, 0 );
+	sensor_msgs::JointStatePtr held = msgs.joint.get();		// Still in a subscriber queue
+	double position = held->position[0];
+
+	publish_cycle( msgs, 1 );
+	EXPECT_NE( msgs.joint.get().get(), held.get() );
+	EXPECT_EQ( msgs.joint.allocations(), 2ul );
+	EXPECT_EQ( held->position[0], position );
+	ASSERT_EQ( msgs.joint.get()->name.size(), 1u );			// Prepared again by init
+	EXPECT_EQ( msgs.joint.get()->position.size(), 1u );
+
+	held.reset();
+	publish_cycle( msgs, 2 );
+	EXPECT_EQ( msgs.joint.allocations(), 2ul );
+}
@@ -0,0 +1,376 @@
+//======================================================================
+/**
+ *  @file
+ *  tactile_calibration_test.cpp
+ *
+ *  @section tactile_calibration_test.cpp_general General file information
+ *
+ *  @brief
+ *  Unit tests of the finger sensor calibration: the file parser accepts
+ *  complete calibrations only, pressures, force and center of pressure
+ *  of known maps, and apply() against apply_scalar().
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section tactile_calibration_test.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "wsg_50/tactile_calibration.h"
+
+
+//------------------------------------------------------------------------
+// Support functions
+//------------------------------------------------------------------------
+
+/** \brief Calibration file with the given text, removed with the object */
+class CalibrationFile
+{
+public:
+	explicit CalibrationFile( const std::string &text )
+	{
+		char name[] = "/tmp/wsg50_calibration_XXXXXX";
+		int fd = mkstemp( name );
+		if ( fd >= 0 )
+		{
+			if ( write( fd, text.data(), text.size() ) != (ssize_t) text.size() ) name[0] = '\0';
+			close( fd );
+		}
+		path_ = name;
+	}
+
+	~CalibrationFile() { unlink( path_.c_str() ); }
+
+	const char * path() const { return path_.c_str(); }
+
+private:
+	std::string path_;
+};
+
+
+/** \brief Load text, return the error (empty on success) */
+static std::string load( TactileCalibration &cal, const std::string &text )
+{
+	CalibrationFile file( text );
+	std::string error;
+
+	if ( cal.load( file.path(), &error ) == 0 ) return std::string();
+	return error.empty() ? std::string( "failed without reason" ) : error;
+}
+
+
+static void fill( float *volts, float value )
+{
+	for ( int i = 0; i < TACTILE_TAXELS; i++ ) volts[i] = value;
+}
+
+
+//------------------------------------------------------------------------
+// Tests: parser
+//------------------------------------------------------------------------
+
+TEST( TactileCalibrationLoad, AcceptsCompleteFile )
+{
+	TactileCalibration cal;
+
+	EXPECT_FALSE( cal.loaded() );
+	EXPECT_EQ( load( cal,
+		"# Comment\n"
+		"pitch 3.4 3.4   # Trailing comment\n"
+		"area 11.56\n"
+		"threshold 2.0\n"
+		"\n"
+		"0 * linear 0.25 60.0\n"
+		"0 12 linear 0.28 58.5\n"
+		"1 * table 0.25 0 0.8 20 1.5 65 2.2 140 3.0 280\r\n" ), "" );
+	EXPECT_TRUE( cal.loaded() );
+}
+
+
+TEST( TactileCalibrationLoad, AcceptsOneFinger )
+{
+	TactileCalibration cal;
+
+	EXPECT_EQ( load( cal, "1 * linear 0 1\n" ), "" );
+}
+
+
+TEST( TactileCalibrationLoad, RejectsMissingFile )
+{
+	TactileCalibration cal;
+	std::string error;
+
+	EXPECT_EQ( cal.load( "/nonexistent/wsg50_calibration.txt", &error ), -1 );
+	EXPECT_NE( error.find( "Can't open" ), std::string::npos ) << error;
+	EXPECT_FALSE( cal.loaded() );
+}
+
+
+TEST( TactileCalibrationLoad, RejectsEmptyFiles )
+{
+	const char *files[] = {
+		"",
+		"\n\n",
+		"# Only comments\n# here\n",
+		"pitch 3.4 3.4\narea 11.56\nthreshold 2\n",		// No taxel
+	};
+
+	for ( const char *text : files )
+	{
+		TactileCalibration cal;
+		EXPECT_NE( load( cal, text ).find( "no taxel calibrated" ), std::string::npos ) << "\"" << text << "\"";
+		EXPECT_FALSE( cal.loaded() );
+	}
+}
+
+
+TEST( TactileCalibrationLoad, RejectsPartialFinger )
+{
+	TactileCalibration cal;
+	std::string text;
+
+	// All taxels of finger 0 but one
+	for ( int i = 0; i < TACTILE_TAXELS; i++ )
+		if ( i != 17 ) text += "0 " + std::to_string( i ) + " linear 0 1\n";
+	EXPECT_NE( load( cal, text ).find( "finger 0: taxel 17 not calibrated" ), std::string::npos );
+
+	EXPECT_NE( load( cal, "0 * linear 0 1\n1 3 table 0 0 1 10\n" ).find( "finger 1: taxel 0" ), std::string::npos );
+
+	text += "0 17 linear 0 1\n";
+	EXPECT_EQ( load( cal, text ), "" );
+}
+
+
+TEST( TactileCalibrationLoad, RejectsMalformedRows )
+{
+	// Statement, then the line expected in the error
+	const struct { const char *text; const char *error; } files[] = {
+		{ "0 * linear 0.25\n", "line 1: linear" },						// Short row
+		{ "0 * linear\n", "line 1: linear" },
+		{ "0 * linear 0.25 60 7\n", "line 1: linear" },					// Extra value
+		{ "0 * linear 0.25 sixty\n", "line 1: linear" },
+		{ "0 * linear nan 60\n", "line 1: linear" },
+		{ "0 * table 0.5 10\n", "line 1: table" },						// One point
+		{ "0 * table 0.5 10 1.0\n", "line 1: table" },					// Odd count
+		{ "0 * table\n", "line 1: table" },
+		{ "0 * table 0.5 10 1.0 20 0.8 30\n", "line 1: table" },		// Non-monotonic
+		{ "0 * table 0.5 10 0.5 20\n", "line 1: table" },				// Repeated V
+		{ "0 * table 0.5 10 x 20\n", "line 1: table" },
+		{ "0 * spline 0 1\n", "line 1: linear or table" },
+		{ "2 * linear 0 1\n", "line 1: unknown statement" },			// Finger
+		{ "0\n", "line 1: unknown statement" },
+		{ "gain 2\n", "line 1: unknown statement" },
+		{ "0 25 linear 0 1\n", "line 1: taxel" },						// Taxel
+		{ "0 -1 linear 0 1\n", "line 1: taxel" },
+		{ "0 1x linear 0 1\n", "line 1: taxel" },
+		{ "pitch 3.4\n", "line 1: pitch" },
+		{ "pitch 3.4 0\n", "line 1: pitch" },
+		{ "pitch 3.4 3.4 3.4\n", "line 1: pitch" },
+		{ "area -1\n", "line 1: area" },
+		{ "area 11.56 mm\n", "line 1: area" },
+		{ "threshold -2\n", "line 1: threshold" },
+		{ "threshold\n", "line 1: threshold" },
+		{ "1 * linear 0 1\n# Comment\n0 * table 1 10 0.5 5\n", "line 3: table" },
+	};
+
+	for ( const auto &file : files )
+	{
+		TactileCalibration cal;
+		std::string error = load( cal, file.text );
+		EXPECT_NE( error.find( file.error ), std::string::npos ) << "\"" << file.text << "\": " << error;
+		EXPECT_FALSE( cal.loaded() );
+	}
+}
+
+
+TEST( TactileCalibrationLoad, KeepsCalibrationOnError )
+{
+	TactileCalibration cal;
+	float volts[TACTILE_TAXELS];
+	tactile_map map;
+
+	ASSERT_EQ( load( cal, "0 * linear 0 10\n" ), "" );
+	EXPECT_NE( load( cal, "0 * linear 0 20\n0 * table 1 0\n" ), "" );
+	EXPECT_NE( load( cal, "" ), "" );
+
+	EXPECT_TRUE( cal.loaded() );
+	fill( volts, 1.0f );
+	cal.apply( 0, volts, &map );
+	EXPECT_FLOAT_EQ( map.pressure[0], 10.0f );
+}
+
+
+//------------------------------------------------------------------------
+// Tests: pressures, force, center of pressure
+//------------------------------------------------------------------------
+
+class TactileCalibrationMap : public ::testing::Test
+{
+protected:
+	void SetUp()
+	{
+		// Rows 2 mm, columns 3 mm apart, 10 mm^2 taxels
+		ASSERT_EQ( load( cal_, "pitch 2 3\narea 10\n"
+							   "0 * linear 0.5 100\n"
+							   "1 * table 1 10 2 20\n" ), "" );
+		fill( volts_, 0.2f );		// Below the offset: negative, i.e. 0
+	}
+
+	/** \brief Same map with apply() and apply_scalar() */
+	void apply( int finger, tactile_map *map )
+	{
+		tactile_map scalar;
+
+		cal_.apply( finger, volts_, map );
+		cal_.apply_scalar( finger, volts_, &scalar );
+		for ( int i = 0; i < TACTILE_TAXELS; i++ ) EXPECT_FLOAT_EQ( map->pressure[i], scalar.pressure[i] ) << i;
+		EXPECT_NEAR( map->force, scalar.force, 1.0E-5f * fabsf( scalar.force ) );	// Other summation order
+		if ( isnan( scalar.cop_x ) )
+		{
+			EXPECT_TRUE( isnan( map->cop_x ) && isnan( map->cop_y ) && isnan( scalar.cop_y ) );
+		}
+		else
+		{
+			EXPECT_NEAR( map->cop_x, scalar.cop_x, 1.0E-5f );
+			EXPECT_NEAR( map->cop_y, scalar.cop_y, 1.0E-5f );
+		}
+	}
+
+	TactileCalibration cal_;
+	float volts_[TACTILE_TAXELS];
+};
+
+
+TEST_F( TactileCalibrationMap, LinearForceAndCop )
+{
+	tactile_map map;
+
+	volts_[7] = 1.5f;		// Row 1, column 2: x 0 mm, y -2 mm, 100 kPa
+	volts_[13] = 1.0f;		// Row 2, column 3: x 3 mm, y 0 mm, 50 kPa
+	apply( 0, &map );
+
+	for ( int i = 0; i < TACTILE_TAXELS; i++ )
+		EXPECT_FLOAT_EQ( map.pressure[i], i == 7 ? 100.0f : i == 13 ? 50.0f : 0.0f ) << i;
+	EXPECT_FLOAT_EQ( map.force, 150.0f * 10.0f * 1.0E-3f );		// kPa * mm^2 = mN
+	EXPECT_FLOAT_EQ( map.cop_x, 1.0f );
+	EXPECT_FLOAT_EQ( map.cop_y, -200.0f / 150.0f );
+}
+
+
+TEST_F( TactileCalibrationMap, CornerTaxels )
+{
+	tactile_map map;
+
+	volts_[0] = 1.5f;							// x -6 mm, y -4 mm
+	volts_[TACTILE_TAXELS - 1] = 1.5f;			// x 6 mm, y 4 mm
+	volts_[TACTILE_COLS - 1] = 2.5f;			// x 6 mm, y -4 mm, 200 kPa
+	apply( 0, &map );
+
+	EXPECT_FLOAT_EQ( map.force, 400.0f * 10.0f * 1.0E-3f );
+	EXPECT_FLOAT_EQ( map.cop_x, ( -6.0f * 100.0f + 6.0f * 100.0f + 6.0f * 200.0f ) / 400.0f );
+	EXPECT_FLOAT_EQ( map.cop_y, ( -4.0f * 100.0f + 4.0f * 100.0f - 4.0f * 200.0f ) / 400.0f );
+}
+
+
+TEST_F( TactileCalibrationMap, Threshold )
+{
+	tactile_map map;
+
+	ASSERT_EQ( load( cal_, "pitch 2 3\narea 10\nthreshold 60\n0 * linear 0.5 100\n" ), "" );
+	volts_[7] = 1.5f;		// 100 kPa
+	volts_[13] = 1.0f;		// 50 kPa, below the threshold
+	apply( 0, &map );
+
+	EXPECT_FLOAT_EQ( map.pressure[7], 100.0f );
+	EXPECT_EQ( map.pressure[13], 0.0f );
+	EXPECT_FLOAT_EQ( map.force, 1.0f );
+	EXPECT_FLOAT_EQ( map.cop_x, 0.0f );
+	EXPECT_FLOAT_EQ( map.cop_y, -2.0f );
+}
+
+
+TEST_F( TactileCalibrationMap, TableInterpolatesAndHolds )
+{
+	tactile_map map;
+
+	volts_[0] = 0.5f;		// Below the table: first pressure
+	volts_[1] = 1.5f;
+	volts_[2] = 1.25f;
+	volts_[3] = 3.0f;		// Above the table: last pressure
+	volts_[4] = TACTILE_VREF + 1.0f;	// Beyond the ADC range
+	volts_[5] = -1.0f;
+	apply( 1, &map );
+
+	EXPECT_NEAR( map.pressure[0], 10.0f, 1.0E-4f );
+	EXPECT_NEAR( map.pressure[1], 15.0f, 1.0E-4f );
+	EXPECT_NEAR( map.pressure[2], 12.5f, 1.0E-4f );
+	EXPECT_NEAR( map.pressure[3], 20.0f, 1.0E-4f );
+	EXPECT_NEAR( map.pressure[4], 20.0f, 1.0E-4f );
+	EXPECT_NEAR( map.pressure[5], 10.0f, 1.0E-4f );
+	for ( int i = 6; i < TACTILE_TAXELS; i++ ) EXPECT_NEAR( map.pressure[i], 10.0f, 1.0E-4f ) << i;
+}
+
+
+TEST_F( TactileCalibrationMap, NoContact )
+{
+	tactile_map map;
+
+	apply( 0, &map );
+	for ( int i = 0; i < TACTILE_TAXELS; i++ ) EXPECT_EQ( map.pressure[i], 0.0f ) << i;
+	EXPECT_EQ( map.force, 0.0f );
+	EXPECT_TRUE( isnan( map.cop_x ) );
+	EXPECT_TRUE( isnan( map.cop_y ) );
+}
+
+
+TEST_F( TactileCalibrationMap, UncalibratedFinger )
+{
+	tactile_map map;
+
+	ASSERT_EQ( load( cal_, "1 * linear 0 100\n" ), "" );
+	fill( volts_, 2.0f );
+	apply( 0, &map );
+	EXPECT_EQ( map.force, 0.0f );
+	EXPECT_TRUE( isnan( map.cop_x ) );
+}
+
+
+TEST_F( TactileCalibrationMap, SimdMatchesScalarMixedModels )
+{
+	std::mt19937 rng( 50 );
+	std::uniform_real_distribution<float> volts( -0.2f, TACTILE_VREF + 0.2f );
+	tactile_map map;
+
+	// Table and linear taxels in the same 4-taxel blocks
+	ASSERT_EQ( load( cal_, "threshold 1\n"
+						   "0 * linear 0.25 60\n"
+						   "0 2 table 0.25 0 0.8 20 1.5 65 2.2 140 3.0 280\n"
+						   "0 13 table 0 0 3.3 330\n"
+						   "0 24 table 0.1 5 0.2 1 3.0 50\n"
+						   "1 * table 0.25 0 0.8 20 1.5 65 2.2 140 3.0 280\n"
+						   "1 5 linear 0.3 70\n" ), "" );
+	for ( int repeat = 0; repeat < 1000; repeat++ )
+	{
+		for ( int i = 0; i < TACTILE_TAXELS; i++ ) volts_[i] = volts( rng );
+		apply( repeat % 2, &map );
+		if ( HasFailure() ) break;
+	}
+}
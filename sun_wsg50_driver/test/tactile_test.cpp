@@ -0,0 +1,130 @@
+//======================================================================
+/**
+ *  @file
+ *  tactile_test.cpp
+ *
+ *  @section tactile_test.cpp_general General file information
+ *
+ *  @brief
+ *  Unit tests of the finger sensor decoding: the SSE2/NEON path of
+ *  tactile_decode() has to give exactly the values of
+ *  tactile_decode_scalar(), for every length (vector blocks of 8 plus
+ *  the scalar tail) and any alignment of input and output.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section tactile_test.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wsg_50/tactile.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define MAX_COUNT			( 4 * TACTILE_TAXELS + 7 )	// Several vector blocks and every tail length
+#define GUARD				-1.0f						// Written around the output
+
+
+//------------------------------------------------------------------------
+// Support functions
+//------------------------------------------------------------------------
+
+static std::vector<unsigned char> random_frame( std::mt19937 &rng, int count )
+{
+	std::uniform_int_distribution<int> byte( 0, 255 );
+	std::vector<unsigned char> raw( 2 * count );
+
+	for ( size_t i = 0; i < raw.size(); i++ ) raw[i] = (unsigned char) byte( rng );
+	return raw;
+}
+
+
+/**
+ * Decode count taxels from raw + in_offset to volts + out_offset with
+ * both paths and compare, including the guard values around the output
+ */
+
+static void expect_same( const std::vector<unsigned char> &frame, int count, int in_offset, int out_offset )
+{
+	std::vector<unsigned char> raw( frame.size() + in_offset + 1 );
+	std::vector<float> simd( count + out_offset + 1, GUARD ), scalar( count + out_offset + 1, GUARD );
+
+	if ( !frame.empty() ) memcpy( &raw[in_offset], &frame[0], frame.size() );
+	tactile_decode( &raw[in_offset], &simd[out_offset], count );
+	tactile_decode_scalar( &raw[in_offset], &scalar[out_offset], count );
+
+	for ( int i = 0; i < count + out_offset + 1; i++ )
+		ASSERT_EQ( simd[i], scalar[i] ) << "count " << count << ", input offset " << in_offset
+										 << ", output offset " << out_offset << ", index " << i;
+	for ( int i = 0; i < out_offset; i++ ) ASSERT_EQ( simd[i], GUARD );
+	ASSERT_EQ( simd[count + out_offset], GUARD );
+}
+
+
+//------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------
+
+TEST( TactileDecode, KnownCounts )
+{
+	const unsigned char raw[] = { 0x00, 0x00, 0xff, 0x0f, 0x00, 0x08, 0xff, 0xff, 0x01, 0x00 };
+	float volts[5];
+
+	tactile_decode( raw, volts, 5 );
+	EXPECT_EQ( volts[0], 0.0f );
+	EXPECT_FLOAT_EQ( volts[1], 4095.0f * TACTILE_VREF / TACTILE_ADC_RANGE );
+	EXPECT_FLOAT_EQ( volts[2], TACTILE_VREF / 2.0f );
+	EXPECT_FLOAT_EQ( volts[3], 65535.0f * TACTILE_VREF / TACTILE_ADC_RANGE );	// Unsigned, not masked
+	EXPECT_FLOAT_EQ( volts[4], TACTILE_VREF / TACTILE_ADC_RANGE );
+}
+
+
+TEST( TactileDecode, SimdMatchesScalarAllLengths )
+{
+	std::mt19937 rng( 49 );
+
+	for ( int count = 0; count <= MAX_COUNT; count++ )
+		for ( int repeat = 0; repeat < 4; repeat++ )
+			expect_same( random_frame( rng, count ), count, 0, 0 );
+}
+
+
+TEST( TactileDecode, SimdMatchesScalarUnaligned )
+{
+	std::mt19937 rng( 50 );
+
+	// Odd byte offsets of the input: the finger blocks follow a head
+	// byte at any position of the response payload
+	for ( int count = 0; count <= MAX_COUNT; count++ )
+		for ( int in_offset = 0; in_offset < 16; in_offset++ )
+			for ( int out_offset = 0; out_offset < 4; out_offset++ )
+				expect_same( random_frame( rng, count ), count, in_offset, out_offset );
+}
+
+
+TEST( TactileDecode, SimdMatchesScalarExtremes )
+{
+	for ( int count = 0; count <= MAX_COUNT; count++ )
+	{
+		expect_same( std::vector<unsigned char>( 2 * count, 0x00 ), count, 1, 1 );
+		expect_same( std::vector<unsigned char>( 2 * count, 0xff ), count, 1, 1 );
+	}
+}
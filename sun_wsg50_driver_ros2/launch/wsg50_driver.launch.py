@@ -0,0 +1,68 @@
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+from launch_ros.parameter_descriptions import ParameterValue
+
+
+def generate_launch_description():
+    # Add further components (e.g. the consumers of width/joint_states) to the same
+    # container to receive the messages intra-process, without serialization
+    driver = ComposableNode(
+        package='sun_wsg50_driver_ros2',
+        plugin='sun_wsg50_driver::WSG50Driver',
+        name='wsg50_driver_sun',
+        parameters=[{
+            'ip': ParameterValue(LaunchConfiguration('gripper_ip'), value_type=str),
+            'port': ParameterValue(LaunchConfiguration('gripper_port'), value_type=int),
+            'local_port': 1501,
+            'protocol': 'tcp',
+            'com_mode': 'script',  # or polling
+            'rate': 50.0,
+            'adaptive_rate': False,
+            'min_rate': 1.0,
+            'max_rate': 500.0,
+            'rate_margin': 0.2,
+            'rate_hysteresis': 0.1,
+            'stamp_mode': 'midpoint',
+            'grasping_force': 500.0,
+            'cache_max_age': 0.05,
+            'state_period': 1.0,
+            'sample_log.path': ParameterValue(LaunchConfiguration('sample_log'), value_type=str),
+            'sample_log.records': 262144,
+            'estimator.enable': ParameterValue(LaunchConfiguration('estimator'), value_type=bool),
+            'estimator.rate': 500.0,
+            'contact.enable': False,
+            'contact.action': 'stop',  # or none
+            'tactile.calibration': ParameterValue(LaunchConfiguration('tactile_calibration'), value_type=str),
+            'tactile.force_measure': False,  # calibrated grasp force as contact finger force
+            'goal_speed_topic': 'goal_speed',
+            'status_topic': 'status',
+            'homing_srv': 'homing',
+            'width_topic': 'width',
+            'joint_states_topic': ParameterValue(LaunchConfiguration('joint_states_topic'), value_type=str),
+            'joint_prefix': ParameterValue(LaunchConfiguration('joint_prefix'), value_type=str),
+        }],
+        extra_arguments=[{'use_intra_process_comms': True}],
+    )
+
+    container = ComposableNodeContainer(
+        name='wsg50_container',
+        namespace='',
+        package='rclcpp_components',
+        executable='component_container_mt',  # estimated joint states while the loop waits
+        composable_node_descriptions=[driver],
+        output='screen',
+    )
+
+    return LaunchDescription([
+        DeclareLaunchArgument('gripper_ip', default_value='192.168.2.110'),
+        DeclareLaunchArgument('gripper_port', default_value='1000'),
+        DeclareLaunchArgument('joint_states_topic', default_value='/wsg/joint_states'),
+        DeclareLaunchArgument('joint_prefix', default_value=''),
+        DeclareLaunchArgument('sample_log', default_value=''),
+        DeclareLaunchArgument('estimator', default_value='false'),
+        DeclareLaunchArgument('tactile_calibration', default_value=''),
+        container,
+    ])
@@ -0,0 +1,930 @@
+//======================================================================
+/**
+ *  @file
+ *  wsg50_component.cpp
+ *
+ *  @section wsg50_component.cpp_general General file information
+ *
+ *  @brief
+ *  Native ROS 2 driver for the WSG50, as a composable node.
+ *
+ *  Same parameters, topics and services as the ROS 1 driver (driver.cpp)
+ *  for the script and polling modes, on top of the same core
+ *  (wsg50_core). Messages are published as unique_ptr, so subscribers
+ *  in the same container with intra-process communication enabled
+ *  receive them without copy or serialization.
+ *
+ *  The timer, subscriptions and services share the default mutually
+ *  exclusive callback group: the core serves one request at a time,
+ *  as with the single threaded spinner of the ROS 1 node. The timer of
+ *  the estimated joint states has a group of its own, so a multi
+ *  threaded executor runs it while the loop waits for the gripper.
+ *
+ *  @date	18.10.2026
+ *
+ *
+ *  @section wsg50_component.cpp_copyright Copyright
+ *
+ *  Copyright 2026 Università della Campania Luigi Vanvitelli
+ *
+ */
+//======================================================================
+
+
+//------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------
+
+#include <string.h>
+#include <errno.h>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp_components/register_node_macro.hpp>
+#include <std_msgs/msg/bool.hpp>
+#include <std_msgs/msg/float64.hpp>
+#include <std_msgs/msg/string.hpp>
+#include <std_msgs/msg/u_int32.hpp>
+#include <std_srvs/srv/empty.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+
+#include "sun_wsg50_common/msg/status.hpp"
+#include "sun_wsg50_common/msg/status_compact.hpp"
+#include "sun_wsg50_common/msg/state_estimate.hpp"
+#include "sun_wsg50_common/msg/contact_event.hpp"
+#include "sun_wsg50_common/msg/tactile.hpp"
+#include "sun_wsg50_common/msg/tactile_pressure.hpp"
+#include "sun_wsg50_common/msg/cmd.hpp"
+#include "sun_wsg50_common/msg/exchange_stats.hpp"
+#include "sun_wsg50_common/msg/command_stats.hpp"
+#include "sun_wsg50_common/msg/clock_stats.hpp"
+#include "sun_wsg50_common/msg/float64_stamped.hpp"
+#include "sun_wsg50_common/srv/move.hpp"
+#include "sun_wsg50_common/srv/conf.hpp"
+#include "sun_wsg50_common/srv/incr.hpp"
+#include "sun_wsg50_common/srv/get_state.hpp"
+
+#include "wsg_50/common.h"
+#include "wsg_50/cmd.h"
+#include "wsg_50/functions.h"
+#include "wsg_50/state_cache.h"
+#include "wsg_50/mailbox.h"
+#include "wsg_50/rate_controller.h"
+#include "wsg_50/timestamp.h"
+#include "wsg_50/clock_sync.h"
+#include "wsg_50/publish_filter.h"
+#include "wsg_50/sample_log.h"
+#include "wsg_50/state_estimator.h"
+#include "wsg_50/contact_detector.h"
+#include "wsg_50/tactile.h"
+#include "wsg_50/tactile_calibration.h"
+
+
+//------------------------------------------------------------------------
+// Macros
+//------------------------------------------------------------------------
+
+#define GRIPPER_MAX_OPEN 110.0
+#define GRIPPER_MIN_OPEN 0.0
+
+
+namespace sun_wsg50_driver
+{
+
+using sun_wsg50_common::msg::Status;
+using sun_wsg50_common::msg::StatusCompact;
+using sun_wsg50_common::msg::StateEstimate;
+using sun_wsg50_common::msg::ContactEvent;
+using sun_wsg50_common::msg::Tactile;
+using sun_wsg50_common::msg::TactilePressure;
+using sun_wsg50_common::msg::Cmd;
+using sun_wsg50_common::msg::ExchangeStats;
+using sun_wsg50_common::msg::ClockStats;
+using sun_wsg50_common::msg::CommandStats;
+using sun_wsg50_common::msg::Float64Stamped;
+using sun_wsg50_common::srv::Move;
+using sun_wsg50_common::srv::Conf;
+using sun_wsg50_common::srv::Incr;
+using sun_wsg50_common::srv::GetState;
+using std_srvs::srv::Empty;
+
+
+/** \brief Publisher with at least one subscriber, in this process or outside */
+template <class Publisher>
+static bool subscribed( const Publisher &pub )
+{
+	return pub->get_subscription_count() > 0 || pub->get_intra_process_subscription_count() > 0;
+}
+
+
+/** \brief Duration from seconds, available in all distributions */
+static rclcpp::Duration seconds( double s )
+{
+	return rclcpp::Duration( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::duration<double>( s ) ) );
+}
+
+
+class WSG50Driver : public rclcpp::Node
+{
+public:
+	explicit WSG50Driver( const rclcpp::NodeOptions &options )
+		: Node( "wsg50_driver", options ), moving_( false ), grasped_( false ), last_stats_( 0.0 ), dropped_( 0 ),
+		  state_flags_( 0 ), state_known_( false ),
+		  speed_command_( 0.0 ), contact_latched_( 0.0 )
+	{
+		std::string ip = declare_parameter( "ip", std::string( "192.168.1.20" ) );
+		int port = declare_parameter( "port", 1000 );
+		int local_port = declare_parameter( "local_port", 1501 );
+		std::string protocol = declare_parameter( "protocol", std::string( "tcp" ) );
+		std::string com_mode = declare_parameter( "com_mode", std::string( "script" ) );
+		double rate = declare_parameter( "rate", 1.0 );
+		double grasping_force = declare_parameter( "grasping_force", 0.0 );
+		cache_max_age_ = declare_parameter( "cache_max_age", 0.05 );
+		state_period_ = declare_parameter( "state_period", 1.0 );
+		loadPublishFilter( "status", filter_status_ );
+		loadPublishFilter( "status_compact", filter_compact_ );
+		loadPublishFilter( "width", filter_width_ );
+		loadPublishFilter( "joint_states", filter_joint_ );
+		std::string sample_log_path = declare_parameter( "sample_log.path", std::string( "" ) );
+		int sample_log_records = declare_parameter( "sample_log.records", 262144 );
+		std::string stamp_mode = declare_parameter( "stamp_mode", std::string( "midpoint" ) );
+		adaptive_rate_ = declare_parameter( "adaptive_rate", false );
+		double min_rate = declare_parameter( "min_rate", 1.0 );
+		double max_rate = declare_parameter( "max_rate", 500.0 );
+		double rate_margin = declare_parameter( "rate_margin", 0.2 );
+		double rate_hysteresis = declare_parameter( "rate_hysteresis", 0.1 );
+		std::string goal_speed_topic = declare_parameter( "goal_speed_topic", std::string( "goal_speed" ) );
+		std::string status_topic = declare_parameter( "status_topic", std::string( "status" ) );
+		std::string homing_srv = declare_parameter( "homing_srv", std::string( "homing" ) );
+		std::string width_topic = declare_parameter( "width_topic", std::string( "width" ) );
+		std::string joint_states_topic = declare_parameter( "joint_states_topic", std::string( "joint_states" ) );
+		std::string joint_prefix = declare_parameter( "joint_prefix", std::string( "" ) );
+		bool estimator_enabled = declare_parameter( "estimator.enable", false );
+		double estimator_rate = declare_parameter( "estimator.rate", 500.0 );
+		std::string joint_states_est_topic = declare_parameter( "estimator.joint_states_topic", joint_states_topic + "_estimated" );
+		state_estimator_params estimator_params = estimator_.params();
+		estimator_params.accel_noise = declare_parameter( "estimator.accel_noise", estimator_params.accel_noise );
+		estimator_params.position_noise = declare_parameter( "estimator.position_noise", estimator_params.position_noise );
+		estimator_params.speed_noise = declare_parameter( "estimator.speed_noise", estimator_params.speed_noise );
+		estimator_params.command_tau = declare_parameter( "estimator.command_tau", estimator_params.command_tau );
+		estimator_params.command_timeout = declare_parameter( "estimator.command_timeout", estimator_params.command_timeout );
+		estimator_params.max_prediction = declare_parameter( "estimator.max_prediction", estimator_params.max_prediction );
+		estimator_.set_params( estimator_params );
+		contact_enabled_ = declare_parameter( "contact.enable", false );
+		std::string contact_action = declare_parameter( "contact.action", std::string( "stop" ) );
+		contact_params contact = contact_.params();
+		contact.min_speed = declare_parameter( "contact.min_speed", contact.min_speed );
+		contact.arm_time = declare_parameter( "contact.arm_time", contact.arm_time );
+		contact.speed_ratio = declare_parameter( "contact.speed_ratio", contact.speed_ratio );
+		contact.collapse_time = declare_parameter( "contact.collapse_time", contact.collapse_time );
+		contact.force_threshold = declare_parameter( "contact.force_threshold", contact.force_threshold );
+		contact.finger_threshold = declare_parameter( "contact.finger_threshold", contact.finger_threshold );
+		contact.closing_only = declare_parameter( "contact.closing_only", contact.closing_only );
+		contact_.set_params( contact );
+		contact_stop_ = ( contact_action != "none" );	// No force control in ROS 2: force_control stops
+		std::string tactile_calibration = declare_parameter( "tactile.calibration", std::string( "" ) );
+		tactile_force_ = declare_parameter( "tactile.force_measure", false );
+
+		// auto_update and streaming need the reader thread of the ROS 1 driver
+		if ( com_mode != "script" && com_mode != "polling" )
+		{
+			RCLCPP_WARN( get_logger(), "com_mode %s not available in ROS 2, using polling", com_mode.c_str() );
+			com_mode = "polling";
+		}
+		script_ = ( com_mode == "script" );
+		joint_name_ = joint_prefix + "gripper_joint";
+
+		if ( !tactile_calibration.empty() && script_ )
+		{
+			std::string error;
+			if ( tactile_cal_.load( tactile_calibration.c_str(), &error ) == 0 )
+				RCLCPP_INFO( get_logger(), "Tactile calibration loaded from %s", tactile_calibration.c_str() );
+			else
+				RCLCPP_ERROR( get_logger(), "Tactile calibration: %s, publishing raw voltages only", error.c_str() );
+		}
+		tactile_force_ = tactile_force_ && tactile_cal_.loaded();
+
+		if ( stamp_mode == "receive" ) timestamp_model().set_mode( STAMP_RECEIVE );
+		else if ( stamp_mode == "learned" ) timestamp_model().set_mode( STAMP_LEARNED );
+		else timestamp_model().set_mode( STAMP_MIDPOINT );
+
+		RCLCPP_INFO( get_logger(), "Connecting to %s:%d (%s); communication mode: %s ...",
+					 ip.c_str(), port, protocol.c_str(), com_mode.c_str() );
+		int res;
+		if ( protocol == "udp" ) res = cmd_connect_udp( local_port, ip.c_str(), port );
+		else res = cmd_connect_tcp( ip.c_str(), port );
+		if ( res != 0 )
+			throw std::runtime_error( "Unable to connect, please check the port and address used." );
+		RCLCPP_INFO( get_logger(), "Gripper connection stablished" );
+
+		// Services
+		services_.push_back( create_service<Move>( "move", std::bind( &WSG50Driver::moveSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+		services_.push_back( create_service<Move>( "grasp", std::bind( &WSG50Driver::graspSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+		services_.push_back( create_service<Move>( "release", std::bind( &WSG50Driver::releaseSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+		services_.push_back( create_service<Empty>( homing_srv, std::bind( &WSG50Driver::homingSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+		services_.push_back( create_service<Empty>( "stop", std::bind( &WSG50Driver::stopSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+		services_.push_back( create_service<Empty>( "ack", std::bind( &WSG50Driver::ackSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+		services_.push_back( create_service<Incr>( "move_incrementally", std::bind( &WSG50Driver::incrementSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+		services_.push_back( create_service<Conf>( "set_acceleration", std::bind( &WSG50Driver::setAccSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+		services_.push_back( create_service<Conf>( "set_force", std::bind( &WSG50Driver::setForceSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+		services_.push_back( create_service<GetState>( "get_state", std::bind( &WSG50Driver::getStateSrv, this, std::placeholders::_1, std::placeholders::_2 ) ) );
+
+		// Subscribers
+		if ( script_ )
+		{
+			sub_position_ = create_subscription<Cmd>( "goal_position", 5,
+				std::bind( &WSG50Driver::positionCb, this, std::placeholders::_1 ) );
+			sub_speed_ = create_subscription<Float64Stamped>( goal_speed_topic, 1,
+				std::bind( &WSG50Driver::speedCb, this, std::placeholders::_1 ) );
+		}
+
+		// Publishers
+		pub_status_ = create_publisher<Status>( status_topic, 1 );
+		pub_status_compact_ = create_publisher<StatusCompact>( status_topic + "_compact", 1 );
+		pub_status_text_ = create_publisher<std_msgs::msg::String>( status_topic + "_text", rclcpp::QoS( 1 ).transient_local() );
+		pub_joint_ = create_publisher<sensor_msgs::msg::JointState>( joint_states_topic, 10 );
+		pub_width_ = create_publisher<Float64Stamped>( width_topic, 1 );
+		pub_exchange_ = create_publisher<ExchangeStats>( "exchange_stats", 1 );
+		pub_command_stats_ = create_publisher<CommandStats>( "command_stats", 1 );
+		if ( script_ )
+		{
+			pub_moving_ = create_publisher<std_msgs::msg::Bool>( "moving", 10 );
+			pub_clock_ = create_publisher<ClockStats>( "clock_stats", 1 );
+			pub_tactile_ = create_publisher<Tactile>( "tactile", 1 );
+			if ( tactile_cal_.loaded() ) pub_pressure_ = create_publisher<TactilePressure>( "tactile_pressure", 1 );
+			if ( contact_enabled_ ) pub_contact_ = create_publisher<ContactEvent>( "contact", 10 );
+		}
+
+		RCLCPP_INFO( get_logger(), "Ready to use, homing now..." );
+		homing();
+
+		if ( grasping_force > 0.0 )
+		{
+			RCLCPP_INFO( get_logger(), "Setting grasping force limit to %5.1f", grasping_force );
+			setGraspingForceLimit( grasping_force );
+		}
+
+		if ( !sample_log_path.empty() )
+		{
+			if ( sample_log_.open( sample_log_path.c_str(), sample_log_records > 0 ? sample_log_records : 1, now().seconds() ) == 0 )
+				RCLCPP_INFO( get_logger(), "Logging samples to %s (%d records)", sample_log_path.c_str(), sample_log_records );
+			else
+				RCLCPP_ERROR( get_logger(), "Unable to create the sample log %s: %s", sample_log_path.c_str(), strerror( errno ) );
+		}
+
+		RCLCPP_INFO( get_logger(), "Init done. Starting timer with target rate %.1f.", rate );
+		if ( adaptive_rate_ )
+		{
+			// Start at the configured rate, then follow the measured round trip time
+			rate_ctrl_ = RateController( rate, min_rate, max_rate, rate_margin, rate_hysteresis );
+			rclcpp::QoS latched = rclcpp::QoS( 1 ).transient_local();
+			pub_rate_ = create_publisher<std_msgs::msg::Float64>( "loop_rate", latched );
+			pub_overruns_ = create_publisher<std_msgs::msg::UInt32>( "loop_overruns", latched );
+		}
+		startTimer( 1.0 / rate );
+		// The script response carries no system state: queried at a low rate on its own timer,
+		// outside the control cycle (same callback group, so never concurrent with loop())
+		if ( script_ && state_period_ > 0.0 )
+			state_timer_ = create_wall_timer( std::chrono::duration<double>( state_period_ ),
+											  std::bind( &WSG50Driver::pollState, this ) );
+
+		if ( estimator_enabled && estimator_rate > 0.0 )
+		{
+			pub_joint_est_ = create_publisher<sensor_msgs::msg::JointState>( joint_states_est_topic, 10 );
+			pub_estimate_ = create_publisher<StateEstimate>( "state_estimate", 10 );
+			estimator_group_ = create_callback_group( rclcpp::CallbackGroupType::MutuallyExclusive );
+			estimator_timer_ = create_wall_timer( std::chrono::duration<double>( 1.0 / estimator_rate ),
+												  std::bind( &WSG50Driver::publishEstimate, this ), estimator_group_ );
+			RCLCPP_INFO( get_logger(), "Publishing estimated joint states at %.1f Hz", estimator_rate );
+		}
+	}
+
+	~WSG50Driver() override
+	{
+		RCLCPP_INFO( get_logger(), "Exiting..." );
+		timer_->cancel();
+		if ( state_timer_ ) state_timer_->cancel();
+		if ( estimator_timer_ ) estimator_timer_->cancel();
+		if ( sample_log_.is_open() )
+		{
+			RCLCPP_INFO( get_logger(), "Samples logged: %lu", (unsigned long) sample_log_.count() );
+			sample_log_.close();
+		}
+		cmd_disconnect();
+	}
+
+private:
+	struct position_goal { float pos, speed; };
+
+	void startTimer( double period )
+	{
+		if ( timer_ ) timer_->cancel();
+		timer_ = create_wall_timer( std::chrono::duration<double>( period ), std::bind( &WSG50Driver::loop, this ) );
+	}
+
+	/** \brief Script mode: system state query, see state_period */
+	void pollState()
+	{
+		unsigned int flags;
+		if ( systemStateFlags( &flags ) == 0 ) updateStateFlags( flags );
+	}
+
+	/** \brief ROS time of the estimated sampling instant of a cached value (now if never sampled) */
+	rclcpp::Time sampleStamp( cache_field_t field )
+	{
+		gripper_state state = state_cache().snapshot();
+		rclcpp::Time t = now();
+
+		if ( state.stamp[field] <= 0.0 ) return t;
+		return t - seconds( StateCache::now() - state.stamp[field] );
+	}
+
+	// ==== Services ====
+
+	/** \brief Width and speed limits of the ROS 1 services, error 255 if the width is out of range */
+	bool checkGoal( float width, float speed, Move::Response &res )
+	{
+		if ( width < 0.0 || width > 110.0 )
+		{
+			RCLCPP_ERROR( get_logger(), "Imposible to move to this position. (Width values: [0.0 - 110.0] " );
+			res.error = 255;
+			return false;
+		}
+		if ( speed <= 0.0 || speed > 420.0 )
+			RCLCPP_WARN( get_logger(), "Speed values are outside the gripper's physical limits ([0.1 - 420.0])  Using clamped values." );
+		return true;
+	}
+
+	void moveSrv( const std::shared_ptr<Move::Request> req, std::shared_ptr<Move::Response> res )
+	{
+		if ( !checkGoal( req->width, req->speed, *res ) ) return;
+		RCLCPP_INFO( get_logger(), "Moving to %f position at %f mm/s.", req->width, req->speed );
+		res->error = move( req->width, req->speed, false );
+		RCLCPP_INFO( get_logger(), "Target position reached." );
+	}
+
+	void graspSrv( const std::shared_ptr<Move::Request> req, std::shared_ptr<Move::Response> res )
+	{
+		if ( !checkGoal( req->width, req->speed, *res ) ) return;
+		RCLCPP_INFO( get_logger(), "Grasping object at %f with %f mm/s.", req->width, req->speed );
+		res->error = grasp( req->width, req->speed );
+		RCLCPP_INFO( get_logger(), "Object grasped correctly." );
+		grasped_ = true;
+	}
+
+	void releaseSrv( const std::shared_ptr<Move::Request> req, std::shared_ptr<Move::Response> res )
+	{
+		if ( !checkGoal( req->width, req->speed, *res ) ) return;
+		RCLCPP_INFO( get_logger(), "Releasing to %f position at %f mm/s.", req->width, req->speed );
+		res->error = release( req->width, req->speed );
+		RCLCPP_INFO( get_logger(), "Object released correctly." );
+	}
+
+	void incrementSrv( const std::shared_ptr<Incr::Request> req, std::shared_ptr<Incr::Response> res )
+	{
+		if ( req->direction == "open" )
+		{
+			if ( grasped_ )
+			{
+				RCLCPP_INFO( get_logger(), "Releasing object..." );
+				release( GRIPPER_MAX_OPEN, 20 );
+				grasped_ = false;
+				return;
+			}
+			float next = getOpeningCached( cache_max_age_ ) + req->increment;
+			if ( next < GRIPPER_MAX_OPEN ) move( next, 20, true );
+			else move( GRIPPER_MAX_OPEN, 1, true );
+		}
+		else if ( req->direction == "close" && !grasped_ )
+		{
+			float next = getOpeningCached( cache_max_age_ ) - req->increment;
+			if ( next > GRIPPER_MIN_OPEN ) move( next, 20, true );
+			else move( GRIPPER_MIN_OPEN, 1, true );
+		}
+	}
+
+	void homingSrv( const std::shared_ptr<Empty::Request>, std::shared_ptr<Empty::Response> )
+	{
+		RCLCPP_INFO( get_logger(), "Homing..." );
+		homing();
+		RCLCPP_INFO( get_logger(), "Home position reached." );
+	}
+
+	void stopSrv( const std::shared_ptr<Empty::Request>, std::shared_ptr<Empty::Response> )
+	{
+		RCLCPP_WARN( get_logger(), "Stop!" );
+		stop();
+		estimator_.command( now().seconds(), 0.0 );
+		speed_command_ = 0.0;
+		RCLCPP_WARN( get_logger(), "Stopped." );
+	}
+
+	void ackSrv( const std::shared_ptr<Empty::Request>, std::shared_ptr<Empty::Response> )
+	{
+		ack_fault();
+	}
+
+	void setAccSrv( const std::shared_ptr<Conf::Request> req, std::shared_ptr<Conf::Response> )
+	{
+		setAcceleration( req->val );
+	}
+
+	void setForceSrv( const std::shared_ptr<Conf::Request> req, std::shared_ptr<Conf::Response> )
+	{
+		setGraspingForceLimit( req->val );
+	}
+
+	/** \brief Opening, speed and force from the state cache, refreshed from the gripper if older than max_age */
+	void getStateSrv( const std::shared_ptr<GetState::Request> req, std::shared_ptr<GetState::Response> res )
+	{
+		double max_age = req->max_age > 0.0 ? req->max_age : cache_max_age_;
+
+		res->width = getOpeningCached( max_age );
+		res->speed = getSpeedCached( max_age );
+		res->force = getForceCached( max_age );
+
+		gripper_state state = state_cache().snapshot();
+		res->age = state.stamp[CACHE_OPENING] > 0.0 ? StateCache::now() - state.stamp[CACHE_OPENING] : -1.0;
+		res->error = 0;
+	}
+
+	// ==== Topics ====
+
+	void positionCb( const Cmd::ConstSharedPtr msg )
+	{
+		position_goal goal = { msg->pos, msg->speed };
+		position_box_.post( goal );
+	}
+
+	void speedCb( const Float64Stamped::ConstSharedPtr msg )
+	{
+		speed_box_.post( msg->data );
+	}
+
+	/** \brief Round trip, setpoint and clock statistics, once per second */
+	void publishLinkStats()
+	{
+		double t = StateCache::now();
+		if ( t - last_stats_ < 1.0 ) return;
+		last_stats_ = t;
+
+		rtt_stats rtt = timestamp_model().stats();
+		auto msg = std::make_unique<ExchangeStats>();
+		msg->header.stamp = now();
+		msg->count = rtt.count;
+		msg->window = rtt.window;
+		msg->rtt_min = rtt.min;
+		msg->rtt_p50 = rtt.p50;
+		msg->rtt_p90 = rtt.p90;
+		msg->rtt_p99 = rtt.p99;
+		msg->rtt_max = rtt.max;
+		msg->rtt_mean = rtt.mean;
+		msg->return_delay = rtt.return_delay;
+		builtin_interfaces::msg::Time stamp = msg->header.stamp;
+		pub_exchange_->publish( std::move( msg ) );
+
+		mailbox_stats pos = position_box_.stats(), speed = speed_box_.stats();
+		auto command_msg = std::make_unique<CommandStats>();
+		command_msg->header.stamp = stamp;
+		command_msg->position_received = pos.posted;
+		command_msg->position_sent = pos.taken;
+		command_msg->position_coalesced = pos.coalesced;
+		command_msg->speed_received = speed.posted;
+		command_msg->speed_sent = speed.taken;
+		command_msg->speed_coalesced = speed.coalesced;
+		pub_command_stats_->publish( std::move( command_msg ) );
+
+		clock_stats clk = clock_sync().stats();
+		if ( !pub_clock_ || clk.samples == 0 ) return;
+		if ( clk.dropped > dropped_ )
+			RCLCPP_WARN( get_logger(), "%lu script samples dropped (%lu in total)", clk.dropped - dropped_, clk.dropped );
+		dropped_ = clk.dropped;
+
+		auto clock_msg = std::make_unique<ClockStats>();
+		clock_msg->header.stamp = stamp;
+		clock_msg->samples = clk.samples;
+		clock_msg->dropped = clk.dropped;
+		clock_msg->duplicated = clk.duplicated;
+		clock_msg->resets = clk.resets;
+		clock_msg->offset = clk.offset;
+		clock_msg->drift_ppm = clk.drift * 1e6;
+		clock_msg->period = clk.period;
+		clock_msg->jitter = clk.jitter;
+		clock_msg->residual = clk.residual;
+		pub_clock_->publish( std::move( clock_msg ) );
+	}
+
+	/** \brief Adapt the timer period to the measured exchange time, publish rate and overruns on change */
+	void adaptRate( double rtt, double duration )
+	{
+		unsigned long overruns = rate_ctrl_.overruns();
+
+		if ( rate_ctrl_.update( rtt, duration ) )
+		{
+			startTimer( rate_ctrl_.period() );
+			auto msg = std::make_unique<std_msgs::msg::Float64>();
+			msg->data = rate_ctrl_.rate();
+			pub_rate_->publish( std::move( msg ) );
+		}
+		if ( rate_ctrl_.overruns() != overruns )
+		{
+			auto msg = std::make_unique<std_msgs::msg::UInt32>();
+			msg->data = rate_ctrl_.overruns();
+			pub_overruns_->publish( std::move( msg ) );
+		}
+	}
+
+	/** \brief Declare publish.<name>.{decimation, width_deadband, force_deadband, max_period} */
+	void loadPublishFilter( const std::string &name, PublishFilter &filter )
+	{
+		publish_filter_params params = filter.params();
+		std::string ns = "publish." + name + ".";
+		params.decimation = declare_parameter( ns + "decimation", params.decimation );
+		params.width_deadband = declare_parameter( ns + "width_deadband", params.width_deadband );
+		params.force_deadband = declare_parameter( ns + "force_deadband", params.force_deadband );
+		params.max_period = declare_parameter( ns + "max_period", params.max_period );
+		filter.set_params( params );
+	}
+
+	/** \brief Append a decoded sample to the binary log, if enabled */
+	void logSample( const rclcpp::Time &stamp, const gripper_response &info )
+	{
+		if ( !sample_log_.is_open() ) return;
+
+		sample_record record;
+		memset( &record, 0, sizeof( record ) );
+		record.stamp = stamp.seconds();
+		record.received = StateCache::now();
+		if ( info.has_clock )
+		{
+			record.flags |= SAMPLE_HAS_CLOCK;
+			record.seq = info.seq;
+			record.device_ms = info.device_ms;
+		}
+		if ( state_known_ )
+		{
+			record.flags |= SAMPLE_HAS_STATE;
+			record.state = state_flags_;
+		}
+		record.position = info.position;
+		record.speed = info.speed;
+		record.force = info.f_motor;
+		record.force_finger0 = info.f_finger0;
+		record.force_finger1 = info.f_finger1;
+		if ( info.tact_finger0 )
+		{
+			record.flags |= SAMPLE_TACTILE0;
+			memcpy( record.tactile0, info.v_finger0, sizeof( record.tactile0 ) );
+		}
+		if ( info.tact_finger1 )
+		{
+			record.flags |= SAMPLE_TACTILE1;
+			memcpy( record.tactile1, info.v_finger1, sizeof( record.tactile1 ) );
+		}
+		sample_log_.append( record );
+	}
+
+	/** \brief Estimated joint state and estimator state, predicted to now */
+	void publishEstimate()
+	{
+		state_estimate estimate;
+		rclcpp::Time t = now();
+		if ( !estimator_.predict( t.seconds(), &estimate ) ) return;
+
+		if ( subscribed( pub_joint_est_ ) )
+		{
+			auto joint_states = std::make_unique<sensor_msgs::msg::JointState>();
+			joint_states->header.stamp = t;
+			joint_states->header.frame_id = "gripper_tool_frame";
+			joint_states->name.push_back( joint_name_ );
+			joint_states->position.push_back( estimate.position / 1000.0 );
+			joint_states->velocity.push_back( estimate.velocity / 1000.0 );
+			joint_states->effort.push_back( state_cache().snapshot().value[CACHE_FORCE] );
+			pub_joint_est_->publish( std::move( joint_states ) );
+		}
+
+		if ( subscribed( pub_estimate_ ) )
+		{
+			auto msg = std::make_unique<StateEstimate>();
+			msg->header.stamp = t;
+			msg->position = estimate.position / 1000.0;
+			msg->velocity = estimate.velocity / 1000.0;
+			for ( int i = 0; i < 4; i++ ) msg->covariance[i] = estimate.covariance[i] / 1.0E6;
+			msg->prediction = estimate.prediction;
+			msg->innovation_position = estimate.innovation_position / 1000.0;
+			msg->innovation_velocity = estimate.innovation_velocity / 1000.0;
+			msg->innovation_rms = estimate.innovation_rms / 1000.0;
+			msg->nis = estimate.nis;
+			msg->samples = estimate.samples;
+			pub_estimate_->publish( std::move( msg ) );
+		}
+	}
+
+	/** \brief Contact detected in loop(): stop the fingers with one more exchange in the same cycle */
+	void handleContact( unsigned int sources, const gripper_response &info, double finger_force, double sampled )
+	{
+		double t_detect = StateCache::now();
+		double stop_latency = 0.0;
+		float command = speed_command_;
+		gripper_response stop_info;
+
+		if ( contact_stop_ )
+		{
+			contact_latched_ = command;
+			if ( script_measure_move( 2, 0, 0.0, stop_info ) ) stop_latency = StateCache::now() - t_detect;
+			estimator_.command( now().seconds(), 0.0 );
+			speed_command_ = 0.0;
+		}
+		contact_.reset();
+
+		RCLCPP_INFO( get_logger(), "Contact (%s%s%s) at %.1f mm, %s after %.1f ms + %.1f ms",
+					 ( sources & CONTACT_FINGER ) ? "finger " : "", ( sources & CONTACT_FORCE ) ? "force " : "",
+					 ( sources & CONTACT_SPEED ) ? "speed" : "", info.position, contact_stop_ ? "stop" : "none",
+					 ( t_detect - sampled ) * 1000.0, stop_latency * 1000.0 );
+
+		auto msg = std::make_unique<ContactEvent>();
+		msg->header.stamp = now() - seconds( t_detect - sampled );
+		msg->source = sources;
+		msg->action = contact_stop_ ? "stop" : "none";
+		msg->width = info.position;
+		msg->speed = info.speed;
+		msg->command_speed = command;
+		msg->force = info.f_motor;
+		msg->finger_force = finger_force;
+		msg->detection_latency = t_detect - sampled;
+		msg->stop_latency = stop_latency;
+		pub_contact_->publish( std::move( msg ) );
+	}
+
+	/** \brief Record the system state bitmask, its text is only rebuilt and published if it changed */
+	void updateStateFlags( unsigned int flags )
+	{
+		if ( state_known_ && flags == state_flags_ ) return;
+		state_flags_ = flags;
+		state_known_ = true;
+		state_text_ = getStateText( flags );
+
+		auto msg = std::make_unique<std_msgs::msg::String>();
+		msg->data = state_text_;
+		pub_status_text_->publish( std::move( msg ) );
+	}
+
+	/** \brief One exchange with the gripper (command and measure in script mode), then publish */
+	void loop()
+	{
+		gripper_response info;
+		memset( &info, 0, sizeof( info ) );
+		float acc = 0.0;
+		double t_cycle = StateCache::now(), t_exchange;
+		tactile_map tactile_maps[2];
+		bool calibrated[2] = { false, false };
+
+		if ( script_ )
+		{
+			position_goal goal;
+			float goal_speed;
+			int res;
+			bool has_position = position_box_.take( &goal );
+			bool has_speed = speed_box_.take( &goal_speed );  // a position goal supersedes it
+
+			// After a contact stop, only a command away from the contact resumes the motion
+			if ( has_speed && contact_latched_ != 0.0 )
+			{
+				if ( goal_speed * contact_latched_ > 0.0 ) goal_speed = 0.0;
+				else contact_latched_ = 0.0;
+			}
+			if ( has_position ) speed_command_ = contact_latched_ = 0.0;
+			else if ( has_speed ) speed_command_ = goal_speed;
+
+			if ( has_position )
+			{
+				RCLCPP_INFO( get_logger(), "Position command: pos=%5.1f, speed=%5.1f", goal.pos, goal.speed );
+				res = script_measure_move( 1, goal.pos, goal.speed, info );
+				estimator_.command_position( now().seconds(), goal.pos, goal.speed );
+			}
+			else if ( has_speed )
+			{
+				res = script_measure_move( 2, 0, goal_speed, info );
+				estimator_.command( now().seconds(), goal_speed );
+			}
+			else res = script_measure_move( 0, 0, 0, info );
+			t_exchange = StateCache::now() - t_cycle;
+
+			if ( !res )
+			{
+				RCLCPP_ERROR( get_logger(), "Measure-and-move command failed" );
+				return;
+			}
+			double finger_force = NAN;
+			if ( tactile_cal_.loaded() )
+			{
+				// Finger forces from the calibrated sensors, in the cycle of the sample
+				calibrated[0] = info.tact_finger0;
+				calibrated[1] = info.tact_finger1;
+				if ( calibrated[0] )
+				{
+					tactile_cal_.apply( 0, info.v_finger0, &tactile_maps[0] );
+					info.f_finger0 = tactile_maps[0].force;
+				}
+				if ( calibrated[1] )
+				{
+					tactile_cal_.apply( 1, info.v_finger1, &tactile_maps[1] );
+					info.f_finger1 = tactile_maps[1].force;
+				}
+				if ( tactile_force_ && ( calibrated[0] || calibrated[1] ) )
+					finger_force = calibrated[0] && calibrated[1] ? ( info.f_finger0 + info.f_finger1 ) / 2.0 :
+								   calibrated[0] ? info.f_finger0 : info.f_finger1;
+			}
+			if ( contact_enabled_ )
+			{
+				// The finger force is the calibrated one
+				double sampled = state_cache().snapshot().stamp[CACHE_OPENING];
+				unsigned int sources = contact_.update( sampled, speed_command_, info.speed, info.f_motor, finger_force );
+				if ( sources ) handleContact( sources, info, finger_force, sampled );
+			}
+			if ( moving_ != info.ismoving )
+			{
+				auto msg = std::make_unique<std_msgs::msg::Bool>();
+				msg->data = info.ismoving;
+				pub_moving_->publish( std::move( msg ) );
+				moving_ = info.ismoving;
+			}
+		}
+		else
+		{
+			unsigned int flags;
+			if ( systemStateFlags( &flags ) != 0 ) return;
+			updateStateFlags( flags );
+			// The loop is what refreshes the cache: always a fresh sample here
+			info.position = getOpening();
+			acc = getAcceleration();
+			info.f_motor = getForce();
+			t_exchange = StateCache::now() - t_cycle;
+		}
+
+		// All messages carry the estimated sampling instant of the opening
+		rclcpp::Time stamp = sampleStamp( CACHE_OPENING );
+		logSample( stamp, info );
+		estimator_.update( stamp.seconds(), info.position, info.speed, script_ );	// polling: no speed
+
+		// Published as unique_ptr: moved, not copied, to intra-process subscribers.
+		// Topics without subscribers are not even filled, the others pass their filter.
+		double t_publish = StateCache::now();
+		if ( subscribed( pub_status_ ) && filter_status_.update( t_publish, info.position, info.f_motor, state_flags_ ) )
+		{
+			auto status = std::make_unique<Status>();
+			status->header.stamp = stamp;
+			status->status = state_text_;
+			status->width = info.position;
+			status->speed = info.speed;
+			status->acc = acc;
+			status->force = info.f_motor;
+			status->force_finger0 = info.f_finger0;
+			status->force_finger1 = info.f_finger1;
+			pub_status_->publish( std::move( status ) );
+		}
+
+		if ( subscribed( pub_status_compact_ ) && filter_compact_.update( t_publish, info.position, info.f_motor, state_flags_ ) )
+		{
+			auto compact = std::make_unique<StatusCompact>();
+			compact->header.stamp = stamp;
+			compact->state = state_flags_;
+			compact->width = info.position;
+			compact->speed = info.speed;
+			compact->acc = acc;
+			compact->force = info.f_motor;
+			compact->force_finger0 = info.f_finger0;
+			compact->force_finger1 = info.f_finger1;
+			pub_status_compact_->publish( std::move( compact ) );
+		}
+
+		if ( subscribed( pub_width_ ) && filter_width_.update( t_publish, info.position, info.f_motor ) )
+		{
+			auto width = std::make_unique<Float64Stamped>();
+			width->header.stamp = stamp;
+			width->data = info.position / 1000.0;	// [mm] to [m]
+			pub_width_->publish( std::move( width ) );
+		}
+
+		if ( subscribed( pub_joint_ ) && filter_joint_.update( t_publish, info.position, info.f_motor ) )
+		{
+			auto joint_states = std::make_unique<sensor_msgs::msg::JointState>();
+			joint_states->header.stamp = stamp;
+			joint_states->header.frame_id = "gripper_tool_frame";
+			joint_states->name.push_back( joint_name_ );
+			joint_states->position.push_back( info.position / 1000.0 );
+			joint_states->velocity.push_back( info.speed / 1000.0 );
+			joint_states->effort.push_back( info.f_motor );
+			pub_joint_->publish( std::move( joint_states ) );
+		}
+
+		if ( ( info.tact_finger0 || info.tact_finger1 ) && subscribed( pub_tactile_ ) )
+		{
+			auto tactile = std::make_unique<Tactile>();
+			tactile->header.stamp = stamp;
+			tactile->header.frame_id = "gripper_tool_frame";
+			tactile->fingers = ( info.tact_finger0 ? Tactile::FINGER0 : 0 ) | ( info.tact_finger1 ? Tactile::FINGER1 : 0 );
+			tactile->rows = TACTILE_ROWS;
+			tactile->cols = TACTILE_COLS;
+			if ( info.tact_finger0 ) std::copy( info.v_finger0, info.v_finger0 + TACTILE_TAXELS, tactile->voltages.begin() );
+			if ( info.tact_finger1 ) std::copy( info.v_finger1, info.v_finger1 + TACTILE_TAXELS, tactile->voltages.begin() + TACTILE_TAXELS );
+			pub_tactile_->publish( std::move( tactile ) );
+		}
+
+		if ( ( calibrated[0] || calibrated[1] ) && subscribed( pub_pressure_ ) )
+		{
+			auto pressure = std::make_unique<TactilePressure>();
+			pressure->header.stamp = stamp;
+			pressure->header.frame_id = "gripper_tool_frame";
+			pressure->fingers = ( calibrated[0] ? TactilePressure::FINGER0 : 0 ) | ( calibrated[1] ? TactilePressure::FINGER1 : 0 );
+			pressure->rows = TACTILE_ROWS;
+			pressure->cols = TACTILE_COLS;
+			float grasp_force = 0.0;
+			for ( int f = 0; f < 2; f++ )
+			{
+				pressure->cop_x[f] = pressure->cop_y[f] = NAN;
+				if ( !calibrated[f] ) continue;
+				std::copy( tactile_maps[f].pressure, tactile_maps[f].pressure + TACTILE_TAXELS,
+						   pressure->pressure.begin() + f * TACTILE_TAXELS );
+				pressure->force[f] = tactile_maps[f].force;
+				pressure->cop_x[f] = tactile_maps[f].cop_x;
+				pressure->cop_y[f] = tactile_maps[f].cop_y;
+				grasp_force += tactile_maps[f].force;
+			}
+			pressure->grasp_force = calibrated[0] && calibrated[1] ? grasp_force / 2.0 : grasp_force;
+			pub_pressure_->publish( std::move( pressure ) );
+		}
+
+		publishLinkStats();
+
+		if ( adaptive_rate_ )
+			adaptRate( t_exchange, StateCache::now() - t_cycle );
+	}
+
+	bool script_;
+	bool adaptive_rate_;
+	double cache_max_age_;		// Max. age of cached state used instead of a round trip [s]
+	std::string joint_name_;
+	bool moving_, grasped_;
+	double last_stats_;
+	unsigned long dropped_;
+
+	// System state bitmask; its text is rebuilt and published (latched) only when it changes
+	unsigned int state_flags_;
+	bool state_known_;
+	std::string state_text_;
+	double state_period_;		// Script mode: period of the system state query [s], 0 disables
+
+	// Per-topic decimation and deadbands
+	PublishFilter filter_status_, filter_compact_, filter_width_, filter_joint_;
+
+	// Binary log of every device sample
+	SampleLog sample_log_;
+
+	// Opening estimator, published by publishEstimate() above the device rate
+	StateEstimator estimator_;
+
+	// Contact detection during speed commands
+	ContactDetector contact_;
+	bool contact_enabled_, contact_stop_;
+	float speed_command_;		// Speed the fingers follow [mm/s], 0 after a position goal or stop
+	float contact_latched_;		// Direction of the stopped motion, speed commands towards it are held
+
+	// Calibrated finger sensor data
+	TactileCalibration tactile_cal_;
+	bool tactile_force_;		// The grasp force is the contact finger force
+
+	// Latest goals from the topics, taken once per exchange with the gripper
+	Mailbox<position_goal> position_box_;
+	Mailbox<float> speed_box_;
+	RateController rate_ctrl_;
+
+	rclcpp::TimerBase::SharedPtr timer_, state_timer_, estimator_timer_;
+	rclcpp::CallbackGroup::SharedPtr estimator_group_;
+	std::vector<rclcpp::ServiceBase::SharedPtr> services_;
+	rclcpp::Subscription<Cmd>::SharedPtr sub_position_;
+	rclcpp::Subscription<Float64Stamped>::SharedPtr sub_speed_;
+	rclcpp::Publisher<Status>::SharedPtr pub_status_;
+	rclcpp::Publisher<StatusCompact>::SharedPtr pub_status_compact_;
+	rclcpp::Publisher<std_msgs::msg::String>::SharedPtr pub_status_text_;
+	rclcpp::Publisher<sensor_msgs::msg::JointState>::SharedPtr pub_joint_, pub_joint_est_;
+	rclcpp::Publisher<StateEstimate>::SharedPtr pub_estimate_;
+	rclcpp::Publisher<ContactEvent>::SharedPtr pub_contact_;
+	rclcpp::Publisher<Tactile>::SharedPtr pub_tactile_;
+	rclcpp::Publisher<TactilePressure>::SharedPtr pub_pressure_;
+	rclcpp::Publisher<Float64Stamped>::SharedPtr pub_width_;
+	rclcpp::Publisher<std_msgs::msg::Bool>::SharedPtr pub_moving_;
+	rclcpp::Publisher<ExchangeStats>::SharedPtr pub_exchange_;
+	rclcpp::Publisher<CommandStats>::SharedPtr pub_command_stats_;
+	rclcpp::Publisher<ClockStats>::SharedPtr pub_clock_;
+	rclcpp::Publisher<std_msgs::msg::Float64>::SharedPtr pub_rate_;
+	rclcpp::Publisher<std_msgs::msg::UInt32>::SharedPtr pub_overruns_;
+};
+
+}  // namespace sun_wsg50_driver
+
+
+RCLCPP_COMPONENTS_REGISTER_NODE( sun_wsg50_driver::WSG50Driver )